@@ -0,0 +1,103 @@
+/*
+//@HEADER
+// *****************************************************************************
+//
+//                           bench_map_reconstruct.cc
+//                           DARMA Toolkit v. 1.0.0
+//                 DARMA/checkpoint => Serialization Library
+//
+// Copyright 2019 National Technology & Engineering Solutions of Sandia, LLC
+// (NTESS). Under the terms of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the following disclaimer.
+//
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// * Neither the name of the copyright holder nor the names of its
+//   contributors may be used to endorse or promote products derived from this
+//   software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact darma@sandia.gov
+//
+// *****************************************************************************
+//@HEADER
+*/
+
+#include "serdes_headers.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <map>
+#include <string>
+#include <unordered_map>
+
+namespace serdes { namespace benchmarks {
+
+using ClockType = std::chrono::steady_clock;
+
+static double secondsSince(ClockType::time_point const start) {
+  return std::chrono::duration<double>(ClockType::now() - start).count();
+}
+
+template <typename MapT>
+static void benchMap(char const* name, std::size_t const num_entries) {
+  MapT map;
+  for (std::size_t i = 0; i < num_entries; i++) {
+    map.emplace("key-" + std::to_string(i), "value-" + std::to_string(i * 7));
+  }
+
+  auto const pack_start = ClockType::now();
+  auto serialized = serializeType(map);
+  auto const pack_time = secondsSince(pack_start);
+
+  auto const& buf = std::get<0>(serialized);
+  auto const& size = std::get<1>(serialized);
+
+  auto const unpack_start = ClockType::now();
+  auto out = deserializeType<MapT>(buf->getBuffer(), size);
+  auto const unpack_time = secondsSince(unpack_start);
+
+  printf(
+    "%-14s entries=%zu bytes=%ld pack=%.3fs unpack=%.3fs %s\n",
+    name, num_entries, size, pack_time, unpack_time,
+    out->size() == map.size() ? "ok" : "MISMATCH"
+  );
+
+  delete out;
+}
+
+}} // end namespace serdes::benchmarks
+
+int main(int argc, char** argv) {
+  using namespace serdes::benchmarks;
+
+  std::size_t const num_entries = argc > 1 ?
+    static_cast<std::size_t>(std::atoll(argv[1])) : 1000000;
+
+  benchMap<std::map<std::string, std::string>>("map", num_entries);
+  benchMap<std::unordered_map<std::string, std::string>>(
+    "unordered_map", num_entries
+  );
+
+  return 0;
+}
@@ -0,0 +1,187 @@
+/*
+//@HEADER
+// *****************************************************************************
+//
+//                               aligned_buffer.h
+//                           DARMA Toolkit v. 1.0.0
+//                 DARMA/checkpoint => Serialization Library
+//
+// Copyright 2019 National Technology & Engineering Solutions of Sandia, LLC
+// (NTESS). Under the terms of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the following disclaimer.
+//
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// * Neither the name of the copyright holder nor the names of its
+//   contributors may be used to endorse or promote products derived from this
+//   software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact darma@sandia.gov
+//
+// *****************************************************************************
+//@HEADER
+*/
+
+#if !defined INCLUDED_SERDES_ALIGNED_BUFFER
+#define INCLUDED_SERDES_ALIGNED_BUFFER
+
+#include "serdes_common.h"
+#include "buffer.h"
+
+#include <memory>
+#include <mutex>
+#include <vector>
+#include <cassert>
+#include <cstdlib>
+
+namespace serdes {
+
+// Default alignment for buffers that are handed to O_DIRECT I/O: this matches
+// the logical block size of virtually all block devices and file systems
+static constexpr SerialSizeType const default_block_size = 4096;
+
+inline SerialSizeType roundUpToBlock(
+  SerialSizeType const& size, SerialSizeType const& block
+) {
+  return ((size + block - 1) / block) * block;
+}
+
+/*
+ * A buffer whose backing storage is aligned to (and sized in multiples of) a
+ * block size so it may be written/read with O_DIRECT. The payload handed out by
+ * getBuffer() may start at an offset into the aligned block to leave room for a
+ * file header in front of the serialized bytes.
+ */
+struct AlignedBuffer : Buffer {
+  using DeleterType = void(*)(void*);
+  using StorageType = std::unique_ptr<SerialByteType, DeleterType>;
+
+  explicit AlignedBuffer(SerialSizeType const& size)
+    : AlignedBuffer(size, default_block_size)
+  { }
+
+  AlignedBuffer(SerialSizeType const& size, SerialSizeType const& alignment)
+    : alignment_(alignment),
+      capacity_(roundUpToBlock(size == 0 ? 1 : size, alignment)),
+      size_(size),
+      block_(allocate(capacity_, alignment_), &std::free)
+  { }
+
+  virtual SerialByteType* getBuffer() const override {
+    return block_.get() + offset_;
+  }
+
+  virtual SerialSizeType getSize() const override {
+    return size_;
+  }
+
+  SerialByteType* getBlock() const { return block_.get(); }
+  SerialSizeType getCapacity() const { return capacity_; }
+  SerialSizeType getAlignment() const { return alignment_; }
+  SerialSizeType getOffset() const { return offset_; }
+
+  void setPayload(SerialSizeType const& offset, SerialSizeType const& size) {
+    assert(offset + size <= capacity_ && "Payload must fit in the block");
+    offset_ = offset;
+    size_ = size;
+  }
+
+private:
+  static SerialByteType* allocate(
+    SerialSizeType const& capacity, SerialSizeType const& alignment
+  ) {
+    void* ptr = nullptr;
+    auto const ret = posix_memalign(&ptr, alignment, capacity);
+    assert(ret == 0 && "posix_memalign failed to allocate aligned buffer");
+    (void)ret;
+    return static_cast<SerialByteType*>(ptr);
+  }
+
+private:
+  SerialSizeType alignment_ = default_block_size;
+  SerialSizeType capacity_ = 0;
+  SerialSizeType offset_ = 0;
+  SerialSizeType size_ = 0;
+  StorageType block_;
+};
+
+/*
+ * Recycles aligned allocations across checkpoints so repeatedly writing large
+ * images does not pay for a fresh (page-faulting) allocation every time.
+ * Buffers are handed back explicitly with release(); anything beyond
+ * max_cached is simply freed.
+ */
+struct AlignedBufferPool {
+  using BufferPtrType = std::unique_ptr<AlignedBuffer>;
+
+  explicit AlignedBufferPool(
+    SerialSizeType const& alignment = default_block_size,
+    std::size_t const max_cached = 4
+  ) : alignment_(alignment), max_cached_(max_cached)
+  { }
+
+  BufferPtrType acquire(SerialSizeType const& size) {
+    std::lock_guard<std::mutex> guard(mutex_);
+
+    // Best-fit: the smallest cached buffer that has enough capacity
+    auto best = free_.end();
+    for (auto it = free_.begin(); it != free_.end(); ++it) {
+      if ((*it)->getCapacity() >= size and
+          (best == free_.end() or
+           (*it)->getCapacity() < (*best)->getCapacity())) {
+        best = it;
+      }
+    }
+
+    if (best != free_.end()) {
+      auto buf = std::move(*best);
+      free_.erase(best);
+      buf->setPayload(0, size);
+      return buf;
+    }
+
+    return std::make_unique<AlignedBuffer>(size, alignment_);
+  }
+
+  void release(BufferPtrType buf) {
+    if (buf == nullptr or buf->getAlignment() != alignment_) {
+      return;
+    }
+    std::lock_guard<std::mutex> guard(mutex_);
+    if (free_.size() < max_cached_) {
+      free_.emplace_back(std::move(buf));
+    }
+  }
+
+  SerialSizeType getAlignment() const { return alignment_; }
+
+private:
+  SerialSizeType const alignment_ = default_block_size;
+  std::size_t const max_cached_ = 4;
+  std::vector<BufferPtrType> free_;
+  std::mutex mutex_;
+};
+
+} /* end namespace serdes */
+
+#endif /*INCLUDED_SERDES_ALIGNED_BUFFER*/
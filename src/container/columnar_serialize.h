@@ -0,0 +1,129 @@
+/*
+//@HEADER
+// *****************************************************************************
+//
+//                             columnar_serialize.h
+//                           DARMA Toolkit v. 1.0.0
+//                 DARMA/checkpoint => Serialization Library
+//
+// Copyright 2019 National Technology & Engineering Solutions of Sandia, LLC
+// (NTESS). Under the terms of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the following disclaimer.
+//
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// * Neither the name of the copyright holder nor the names of its
+//   contributors may be used to endorse or promote products derived from this
+//   software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact darma@sandia.gov
+//
+// *****************************************************************************
+//@HEADER
+*/
+
+#if !defined INCLUDED_SERDES_COLUMNAR_SERIALIZE
+#define INCLUDED_SERDES_COLUMNAR_SERIALIZE
+
+#include "serdes_common.h"
+#include "serializers/serializers_headers.h"
+#include "container_serialize.h"
+#include "traits/field_list.h"
+
+#include <cstring>
+#include <type_traits>
+#include <vector>
+
+namespace serdes {
+
+// Moves one column (all values of one field) between the vector and the buffer
+template <typename Serializer, typename T, typename VectorAllocator>
+struct ColumnSerializer {
+  ColumnSerializer(Serializer& in_s, std::vector<T, VectorAllocator>& in_vec)
+    : s(in_s), vec(in_vec)
+  { }
+
+  template <typename FieldT>
+  void operator()() {
+    using MemberT = typename FieldT::MemberType;
+
+    static_assert(
+      isByteCopyableElm<MemberT>::value,
+      "Columnar fields must be byte-copyable"
+    );
+
+    auto const num = vec.size();
+    auto const spot = s.isSizing() ?
+      nullptr : s.getSpotIncrement(num * sizeof(MemberT));
+
+    if (s.isSizing()) {
+      Serializer::contiguousTyped(s, static_cast<MemberT*>(nullptr), num);
+    } else if (spot == nullptr) {
+      for (auto&& elm : vec) {
+        Serializer::contiguousTyped(s, &FieldT::get(elm), 1);
+      }
+    } else if (s.isUnpacking()) {
+      auto base = reinterpret_cast<SerialByteType*>(vec.data()) + FieldT::offset;
+      for (std::size_t i = 0; i < num; i++) {
+        std::memcpy(base + i * sizeof(T), spot + i * sizeof(MemberT), sizeof(MemberT));
+      }
+    } else {
+      auto base = reinterpret_cast<SerialByteType*>(vec.data()) + FieldT::offset;
+      for (std::size_t i = 0; i < num; i++) {
+        std::memcpy(spot + i * sizeof(MemberT), base + i * sizeof(T), sizeof(MemberT));
+      }
+    }
+  }
+
+  Serializer& s;
+  std::vector<T, VectorAllocator>& vec;
+};
+
+/*
+ * Opt-in structure-of-arrays encoding for vectors of structs with a declared
+ * member list (see SERDES_FIELDS): the element count, then each field as its
+ * own contiguous column in declaration order. Padding is not written. The
+ * wire format differs from `s | vec`, so both sides must use this call.
+ */
+template <typename Serializer, typename T, typename VectorAllocator>
+void serializeColumnar(Serializer& s, std::vector<T, VectorAllocator>& vec) {
+  static_assert(hasFields<T>::value, "Columnar encoding needs SERDES_FIELDS");
+  static_assert(
+    std::is_standard_layout<T>::value, "Columnar types must be standard-layout"
+  );
+
+  SerialSizeType vec_size = vec.size();
+  serializeVarint(s, vec_size);
+
+  if (s.isUnpacking()) {
+    vec.resize(vec_size);
+  } else {
+    s.addOwnedStorage(&vec, vec.data(), vec_size * sizeof(T));
+  }
+
+  forEachField<T>(ColumnSerializer<Serializer, T, VectorAllocator>(s, vec));
+}
+
+} /* end namespace serdes */
+
+#endif /*INCLUDED_SERDES_COLUMNAR_SERIALIZE*/
@@ -47,20 +47,107 @@
 
 #include "serdes_common.h"
 #include "serializers/serializers_headers.h"
+#include "traits/serializable_traits.h"
+#include "varint_serialize.h"
+
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <type_traits>
 
 namespace serdes {
 
+/*
+ * Element types whose packed representation is their raw bytes; containers
+ * of these can be rebuilt straight from the unpack buffer
+ */
+template <typename T>
+struct isByteCopyableElm : std::integral_constant<
+  bool,
+  #if HAS_DETECTION_COMPONENT
+    SerializableTraits<T>::is_bytecopyable
+  #else
+    std::is_arithmetic<T>::value
+  #endif
+> { };
+
+// Fill [it, end) from `spot`, issuing one memcpy per run of adjacent elements
+template <typename T, typename IterT>
+inline void copyRunsFromBytes(
+  IterT it, IterT const end, SerialByteType const* spot
+) {
+  while (it != end) {
+    T* const run = &*it;
+    SerialSizeType len = 1;
+    for (++it; it != end and &*it == run + len; ++it) {
+      len++;
+    }
+    std::memcpy(run, spot, len * sizeof(T));
+    spot += len * sizeof(T);
+  }
+}
+
+/*
+ * Append `num` byte-copyable elements read directly from `spot`. An aligned
+ * span is range-inserted without value-initializing the destination first; a
+ * misaligned one is grown with resize() and then filled by bulk memcpy.
+ */
+template <typename T, typename ContainerT>
+inline void appendFromBytes(
+  ContainerT& cont, SerialByteType const* spot, SerialSizeType num
+) {
+  if (reinterpret_cast<std::uintptr_t>(spot) % alignof(T) == 0) {
+    auto const first = reinterpret_cast<T const*>(spot);
+    cont.insert(cont.end(), first, first + num);
+  } else if (num > 0) {
+    auto const old_size = cont.size();
+    cont.resize(old_size + num);
+    auto const first = std::next(cont.begin(), old_size);
+    copyRunsFromBytes<typename ContainerT::value_type>(first, cont.end(), spot);
+  }
+}
+
+template <typename T, typename ContainerT>
+inline void assignFromBytes(
+  ContainerT& cont, SerialByteType const* spot, SerialSizeType num
+) {
+  cont.clear();
+  cont.reserve(num);
+  appendFromBytes<T>(cont, spot, num);
+}
+
+/*
+ * Copy byte-copyable elements out to `spot`, issuing one memcpy per run of
+ * elements that are adjacent in memory (e.g., a deque's blocks)
+ */
+template <typename T, typename ContainerT>
+inline void copyRunsToBytes(ContainerT& cont, SerialByteType* spot) {
+  auto it = cont.begin();
+  auto const end = cont.end();
+  while (it != end) {
+    T const* const run = &*it;
+    SerialSizeType len = 1;
+    for (++it; it != end and &*it == run + len; ++it) {
+      len++;
+    }
+    std::memcpy(spot, run, len * sizeof(T));
+    spot += len * sizeof(T);
+  }
+}
+
 template <typename Serializer, typename ContainerT>
 inline typename ContainerT::size_type
 serializeContainerSize(Serializer& s, ContainerT& cont) {
   typename ContainerT::size_type cont_size = cont.size();
-  s | cont_size;
+  serializeVarint(s, cont_size);
   return cont_size;
 }
 
+// Each element (e.g., a map node's value) is storage owned by the container
 template <typename Serializer, typename ContainerT>
 inline void serializeContainerElems(Serializer& s, ContainerT& cont) {
   for (auto&& elm : cont) {
+    s.addOwnedStorage(&cont, &elm, sizeof(elm));
     s | elm;
   }
 }
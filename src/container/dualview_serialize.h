@@ -0,0 +1,157 @@
+/*
+//@HEADER
+// *****************************************************************************
+//
+//                             dualview_serialize.h
+//                           DARMA Toolkit v. 1.0.0
+//                 DARMA/checkpoint => Serialization Library
+//
+// Copyright 2019 National Technology & Engineering Solutions of Sandia, LLC
+// (NTESS). Under the terms of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the following disclaimer.
+//
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// * Neither the name of the copyright holder nor the names of its
+//   contributors may be used to endorse or promote products derived from this
+//   software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact darma@sandia.gov
+//
+// *****************************************************************************
+//@HEADER
+*/
+
+#if !defined INCLUDED_SERDES_CONTAINER_DUALVIEW_SERIALIZE_H
+#define INCLUDED_SERDES_CONTAINER_DUALVIEW_SERIALIZE_H
+
+#include "serdes_common.h"
+#include "serializers/serializers_headers.h"
+#include "container/view_serialize.h"
+
+#if KOKKOS_ENABLED_SERDES
+
+#include <Kokkos_Core.hpp>
+#include <Kokkos_View.hpp>
+#include <Kokkos_DualView.hpp>
+
+#include <type_traits>
+
+namespace serdes {
+
+/*
+ * Serialization of a Kokkos::DualView as the Kokkos::View of whichever side
+ * is current, so the wire format is that of its host view (t_host). The
+ * modify flags pick the side; neither packing nor sizing syncs the DualView
+ * or changes its flags:
+ *
+ *   - host up to date: the host view is serialized directly, with no copy
+ *   - device modified: the device view is serialized directly when its
+ *     memory is host-accessible (e.g., host-only execution spaces), otherwise
+ *     through a temporary host copy of the device data
+ *
+ * Unpacking restores into the host side, mirrors it on the device side (an
+ * alias when both sides share a memory space) and marks the host modified, so
+ * the next sync_device() moves the data.
+ */
+
+template <typename DualViewType>
+using DualViewDeviceHostAccessible = std::integral_constant<
+  bool,
+  Kokkos::SpaceAccessibility<
+    Kokkos::HostSpace, typename DualViewType::t_dev::memory_space
+  >::accessible
+>;
+
+template <typename SerializerT, typename DualViewType>
+inline void serializeDualViewDevice(
+  SerializerT& s, DualViewType& dv, std::true_type
+) {
+  s | dv.d_view;
+}
+
+template <typename SerializerT, typename DualViewType>
+inline void serializeDualViewDevice(
+  SerializerT& s, DualViewType& dv, std::false_type
+) {
+  using HostViewType = typename DualViewType::t_host;
+
+  HostViewType tmp(
+    Kokkos::view_alloc(dv.d_view.label(), Kokkos::WithoutInitializing),
+    dv.d_view.layout()
+  );
+  Kokkos::deep_copy(tmp, dv.d_view);
+  s | tmp;
+}
+
+// Device side for an unpacked host view, typed as t_dev rather than as
+// whatever create_mirror_view returns: an alias when the spaces match
+template <typename DualViewType>
+inline typename DualViewType::t_dev dualViewDeviceFor(
+  typename DualViewType::t_host const& host, std::true_type
+) {
+  return host;
+}
+
+template <typename DualViewType>
+inline typename DualViewType::t_dev dualViewDeviceFor(
+  typename DualViewType::t_host const& host, std::false_type
+) {
+  return typename DualViewType::t_dev(
+    Kokkos::view_alloc(host.label(), Kokkos::WithoutInitializing),
+    host.layout()
+  );
+}
+
+template <typename SerializerT, typename... Args>
+inline void serialize(SerializerT& s, Kokkos::DualView<Args...>& dv) {
+  using DualViewType = Kokkos::DualView<Args...>;
+  using HostViewType = typename DualViewType::t_host;
+  using DevViewType = typename DualViewType::t_dev;
+  using SameSpace = std::is_same<
+    typename DevViewType::memory_space, typename HostViewType::memory_space
+  >;
+
+  if (s.isUnpacking()) {
+    HostViewType host;
+    s | host;
+    DevViewType dev = dualViewDeviceFor<DualViewType>(host, SameSpace{});
+    dv = DualViewType(dev, host);
+    dv.modify_host();
+    return;
+  }
+
+  if (not dv.need_sync_host()) {
+    s | dv.h_view;
+  } else {
+    serializeDualViewDevice(
+      s, dv, DualViewDeviceHostAccessible<DualViewType>{}
+    );
+  }
+}
+
+} /* end namespace serdes */
+
+#endif /*KOKKOS_ENABLED_SERDES*/
+
+#endif /*INCLUDED_SERDES_CONTAINER_DUALVIEW_SERIALIZE_H*/
@@ -15,9 +15,12 @@ template <
   typename Underlying = std::underlying_type_t<Enum>
 >
 void serializeEnum(Serializer& s, Enum& e) {
-    Underlying u = static_cast<Underlying>(e);
-    s | u;
-    e = static_cast<Enum>(u);
+  static_assert(
+    sizeof(Enum) == sizeof(Underlying), "Enum must match its underlying type"
+  );
+  // An enum is laid out as its underlying type: move it in place rather than
+  // through a temporary
+  Serializer::contiguousTyped(s, &e, 1);
 }
 
 } /* end namespace serdes */
@@ -0,0 +1,153 @@
+/*
+//@HEADER
+// *****************************************************************************
+//
+//                            immutable_serialize.h
+//                           DARMA Toolkit v. 1.0.0
+//                 DARMA/checkpoint => Serialization Library
+//
+// Copyright 2019 National Technology & Engineering Solutions of Sandia, LLC
+// (NTESS). Under the terms of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the following disclaimer.
+//
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// * Neither the name of the copyright holder nor the names of its
+//   contributors may be used to endorse or promote products derived from this
+//   software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact darma@sandia.gov
+//
+// *****************************************************************************
+//@HEADER
+*/
+
+#if !defined INCLUDED_SERDES_IMMUTABLE_SERIALIZE
+#define INCLUDED_SERDES_IMMUTABLE_SERIALIZE
+
+#include "serdes_common.h"
+#include "serializers/serializers_headers.h"
+#include "dispatch/dispatch.h"
+#include "buffer/user_buffer.h"
+
+#include <memory>
+#include <utility>
+#include <vector>
+
+namespace serdes {
+
+/*
+ * Opt-in wrapper for a sub-object that does not change after setup (meshes,
+ * lookup tables). Its packed bytes are produced once and cached; afterwards
+ * sizing costs O(1) and packing is a single memcpy of the cache. The bytes on
+ * the wire are exactly those of T packed on its own, with no interned strings,
+ * and the cache is rebuilt when the wire mode changes.
+ *
+ * Mutable access goes through mutate(), which drops the cache.
+ */
+template <typename T>
+struct Immutable {
+  Immutable() = default;
+
+  explicit Immutable(T in_value)
+    : value_(std::move(in_value))
+  { }
+
+  T const& get() const { return value_; }
+  T const& operator*() const { return value_; }
+  T const* operator->() const { return &value_; }
+
+  T& mutate() {
+    invalidate();
+    return value_;
+  }
+
+  void invalidate() {
+    cache_.clear();
+    cached_ = false;
+  }
+
+  bool isCached() const { return cached_; }
+  SerialSizeType getCachedSize() const { return cache_.size(); }
+
+  template <typename SerializerT>
+  void serialize(SerializerT& s) {
+    // The cached bytes are spliced into any message, so they must not refer
+    // to the message's string table: strings inside are never interned
+    auto const table = s.getStringTable();
+    s.setStringTable(nullptr);
+
+    if (s.isUnpacking()) {
+      // Keep the bytes we were unpacked from as the cache, when reachable
+      auto const begin = s.getSpotIncrement(0);
+      s | value_;
+      auto const end = s.getSpotIncrement(0);
+      if (begin != nullptr and end != nullptr) {
+        cache_.assign(begin, end);
+        cache_mode_ = s.getWireMode();
+        cached_ = true;
+      } else {
+        invalidate();
+      }
+    } else {
+      buildCache(s.getWireMode());
+      SerializerT::contiguousTyped(s, cache_.data(), cache_.size());
+    }
+
+    s.setStringTable(table);
+  }
+
+private:
+  void buildCache(eWireMode const mode) {
+    if (cached_ and cache_mode_ == mode) {
+      return;
+    }
+
+    using DispatchT = DispatchCommon<T>;
+    using CleanT = typename DispatchT::CleanT;
+    auto val = DispatchT::clean(&value_);
+
+    Sizer sizer;
+    sizer.setWireMode(mode);
+    SerializerDispatch<Sizer, CleanT>()(sizer, val, 1);
+
+    auto const size = sizer.getSize();
+    cache_.resize(size);
+    PackerUserBuf packer(size, std::make_unique<UserBuffer>(cache_.data(), size));
+    packer.setWireMode(mode);
+    SerializerDispatch<PackerUserBuf, CleanT>()(packer, val, 1);
+
+    cache_mode_ = mode;
+    cached_ = true;
+  }
+
+private:
+  T value_ = {};
+  std::vector<SerialByteType> cache_;
+  eWireMode cache_mode_ = eWireMode::Fixed;
+  bool cached_ = false;
+};
+
+} /* end namespace serdes */
+
+#endif /*INCLUDED_SERDES_IMMUTABLE_SERIALIZE*/
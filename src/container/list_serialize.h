@@ -51,37 +51,69 @@
 
 #include <list>
 #include <deque>
+#include <type_traits>
 
 namespace serdes {
 
-template <typename Serializer, typename ContainerT, typename ElmT>
+template <typename Serializer, typename ContainerT>
 inline void deserializeOrderedElems(
   Serializer& s, ContainerT& cont, typename ContainerT::size_type size
 ) {
+  // Unpack each element in place at the back instead of copying a temporary
   for (typename ContainerT::size_type i = 0; i < size; i++) {
-    #pragma GCC diagnostic push
-    #pragma GCC diagnostic ignored "-Wunknown-pragmas"
-    #pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
-    ElmT elm;
-    s | elm;
-    cont.push_back(elm);
-    #pragma GCC diagnostic pop
+    cont.emplace_back();
+    s | cont.back();
   }
 }
 
 template <typename Serializer, typename ContainerT>
-inline void serializeOrderedContainer(Serializer& s, ContainerT& cont) {
+inline void serializeOrderedElems(
+  Serializer& s, ContainerT& cont, typename ContainerT::size_type size,
+  std::false_type
+) {
+  if (s.isUnpacking()) {
+    deserializeOrderedElems<Serializer, ContainerT>(s, cont, size);
+  } else {
+    serializeContainerElems<Serializer, ContainerT>(s, cont);
+  }
+}
+
+/*
+ * Byte-copyable elements are laid out exactly as a contiguous array would be,
+ * so they move in bulk: one memcpy per contiguous run when packing and one
+ * range insert when unpacking, rather than one contiguousBytes per element
+ */
+template <typename Serializer, typename ContainerT>
+inline void serializeOrderedElems(
+  Serializer& s, ContainerT& cont, typename ContainerT::size_type size,
+  std::true_type
+) {
   using ValueT = typename ContainerT::value_type;
 
-  typename ContainerT::size_type size = serializeContainerSize(s, cont);
+  if (s.isSizing()) {
+    Serializer::contiguousTyped(s, static_cast<ValueT*>(nullptr), size);
+    return;
+  }
 
-  if (s.isUnpacking()) {
-    deserializeOrderedElems<Serializer, ContainerT, ValueT>(s, cont, size);
+  auto const spot = s.getSpotIncrement(size * sizeof(ValueT));
+  if (spot == nullptr) {
+    serializeOrderedElems(s, cont, size, std::false_type{});
+  } else if (s.isUnpacking()) {
+    appendFromBytes<ValueT>(cont, spot, size);
   } else {
-    serializeContainerElems<Serializer, ContainerT>(s, cont);
+    copyRunsToBytes<ValueT>(cont, spot);
   }
 }
 
+template <typename Serializer, typename ContainerT>
+inline void serializeOrderedContainer(Serializer& s, ContainerT& cont) {
+  using ValueT = typename ContainerT::value_type;
+
+  typename ContainerT::size_type size = serializeContainerSize(s, cont);
+
+  serializeOrderedElems(s, cont, size, isByteCopyableElm<ValueT>{});
+}
+
 template <typename Serializer, typename T>
 inline void serialize(Serializer& s, std::list<T>& lst) {
   serializeOrderedContainer(s, lst);
@@ -97,10 +129,9 @@ template <typename Serializer, typename ContainerT, typename ElmT>
 inline void deparserdesOrderedElems(
   Serializer& s, ContainerT& cont, typename ContainerT::size_type size
 ) {
-  for (auto i = 0; i < size; i++) {
-    ElmT elm;
-    s & elm;
-    cont.push_back(elm);
+  for (typename ContainerT::size_type i = 0; i < size; i++) {
+    cont.emplace_back();
+    s & cont.back();
   }
 }
 
@@ -53,20 +53,84 @@
 #include <unordered_map>
 #include <set>
 #include <unordered_set>
+#include <utility>
 
 namespace serdes {
 
+/*
+ * Element type used while reconstructing: maps unpack into a pair with a
+ * mutable key so the element can be moved (not copied) into the container
+ */
+template <typename ElmT>
+struct ReconstructElm {
+  using type = ElmT;
+};
+
+template <typename T, typename U>
+struct ReconstructElm<std::pair<T const, U>> {
+  using type = std::pair<T, U>;
+};
+
+/*
+ * Unordered containers size their bucket array once up front instead of
+ * rehashing repeatedly as elements arrive
+ */
+template <typename ContainerT>
+inline void reserveMapLikeContainer(
+  ContainerT&, typename ContainerT::size_type
+) { }
+
+template <typename T, typename U, typename Hash, typename Eq>
+inline void reserveMapLikeContainer(
+  std::unordered_map<T, U, Hash, Eq>& cont,
+  typename std::unordered_map<T, U, Hash, Eq>::size_type size
+) {
+  cont.reserve(size);
+}
+
+template <typename T, typename U, typename Hash, typename Eq>
+inline void reserveMapLikeContainer(
+  std::unordered_multimap<T, U, Hash, Eq>& cont,
+  typename std::unordered_multimap<T, U, Hash, Eq>::size_type size
+) {
+  cont.reserve(size);
+}
+
+template <typename T, typename Hash, typename Eq>
+inline void reserveMapLikeContainer(
+  std::unordered_set<T, Hash, Eq>& cont,
+  typename std::unordered_set<T, Hash, Eq>::size_type size
+) {
+  cont.reserve(size);
+}
+
+template <typename T, typename Hash, typename Eq>
+inline void reserveMapLikeContainer(
+  std::unordered_multiset<T, Hash, Eq>& cont,
+  typename std::unordered_multiset<T, Hash, Eq>::size_type size
+) {
+  cont.reserve(size);
+}
+
+/*
+ * Elements were serialized in iteration order, so for ordered containers each
+ * one belongs at the end: hinting with end() makes the build O(n) overall
+ */
 template <typename Serializer, typename ContainerT, typename ElmT>
 inline void deserializeEmplaceElems(
   Serializer& s, ContainerT& cont, typename ContainerT::size_type size
 ) {
+  using ReconstructT = typename ReconstructElm<ElmT>::type;
+
+  reserveMapLikeContainer(cont, size);
+
   for (typename ContainerT::size_type i = 0; i < size; i++) {
     #pragma GCC diagnostic push
     #pragma GCC diagnostic ignored "-Wunknown-pragmas"
     #pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
-    ElmT elm;
+    ReconstructT elm;
     s | elm;
-    cont.emplace(elm);
+    cont.emplace_hint(cont.end(), std::move(elm));
     #pragma GCC diagnostic pop
   }
 }
@@ -129,10 +193,14 @@ template <typename Serializer, typename ContainerT, typename ElmT>
 inline void deparserdesEmplaceElems(
   Serializer& s, ContainerT& cont, typename ContainerT::size_type size
 ) {
-  for (auto i = 0; i < size; i++) {
-    ElmT elm;
+  using ReconstructT = typename ReconstructElm<ElmT>::type;
+
+  reserveMapLikeContainer(cont, size);
+
+  for (typename ContainerT::size_type i = 0; i < size; i++) {
+    ReconstructT elm;
     s & elm;
-    cont.emplace(elm);
+    cont.emplace_hint(cont.end(), std::move(elm));
   }
 }
 
@@ -47,7 +47,9 @@
 
 #include "serdes_common.h"
 #include "serializers/serializers_headers.h"
+#include "container_serialize.h"
 
+#include <cassert>
 #include <string>
 
 namespace serdes {
@@ -55,14 +57,66 @@ namespace serdes {
 template <typename Serializer>
 void serializeStringMeta(Serializer& s, std::string& str) {
   SerialSizeType str_size = str.size();
-  s | str_size;
+  serializeVarint(s, str_size);
   str.resize(str_size);
 }
 
 template <typename Serializer>
 void serialize(Serializer& s, std::string& str) {
-  serializeStringMeta(s, str);
-  serializeArray(s, str.c_str(), str.size());
+  if (s.isUnpacking()) {
+    SerialSizeType str_size = 0;
+    serializeVarint(s, str_size);
+
+    // Copy the characters in one pass rather than zero-filling them first
+    auto const spot = s.getSpotIncrement(str_size);
+    if (spot != nullptr) {
+      str.assign(reinterpret_cast<char const*>(spot), str_size);
+      return;
+    }
+    str.resize(str_size);
+  } else {
+    serializeStringMeta(s, str);
+  }
+  serializeOwnedArray(s, &str, str.c_str(), str.size());
+}
+
+/*
+ * A string interned in the serializer's per-message StringTable, when one is
+ * attached (compact wire mode): a varint reference where 0 introduces a new
+ * string that follows in full and k > 0 names the (k-1)-th string already in
+ * the message. Without a table this is plain string serialization.
+ */
+template <typename Serializer>
+void serializeInterned(Serializer& s, std::string& str) {
+  auto const table = s.getStringTable();
+  if (table == nullptr) {
+    s | str;
+    return;
+  }
+
+  if (s.isUnpacking()) {
+    auto const ref = static_cast<SerialSizeType>(readVarint(s));
+    if (ref == 0) {
+      s | str;
+      auto const added = table->add(str);
+      assert(added && "Interned string repeated; string table out of sync");
+      (void)added;
+    } else {
+      auto const entry = table->get(ref - 1);
+      assert(entry != nullptr && "String table reference out of range");
+      if (entry != nullptr) {
+        str = *entry;
+      } else {
+        str.clear();
+      }
+    }
+  } else {
+    auto const entry = table->intern(str);
+    writeVarint(s, entry.second ? 0 : entry.first + 1);
+    if (entry.second) {
+      s | str;
+    }
+  }
 }
 
 template <typename Serializer>
@@ -0,0 +1,167 @@
+/*
+//@HEADER
+// *****************************************************************************
+//
+//                              varint_serialize.h
+//                           DARMA Toolkit v. 1.0.0
+//                 DARMA/checkpoint => Serialization Library
+//
+// Copyright 2019 National Technology & Engineering Solutions of Sandia, LLC
+// (NTESS). Under the terms of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the following disclaimer.
+//
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// * Neither the name of the copyright holder nor the names of its
+//   contributors may be used to endorse or promote products derived from this
+//   software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact darma@sandia.gov
+//
+// *****************************************************************************
+//@HEADER
+*/
+
+#if !defined INCLUDED_SERDES_VARINT_SERIALIZE
+#define INCLUDED_SERDES_VARINT_SERIALIZE
+
+#include "serdes_common.h"
+#include "serializers/serializers_headers.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <type_traits>
+#include <vector>
+
+namespace serdes {
+
+template <typename Serializer>
+inline uint64_t readVarint(Serializer& s) {
+  uint64_t raw = 0;
+  auto const spot = s.getSpotIncrement(0);
+  if (spot != nullptr) {
+    auto const avail = s.getRemaining();
+    auto const len = decodeVarint(spot, avail, raw);
+    assert(len != 0 && "Truncated varint in buffer");
+    s.getSpotIncrement(len != 0 ? len : avail);
+  } else {
+    for (unsigned shift = 0; shift < 64; shift += 7) {
+      SerialByteType byte = 0;
+      s.contiguousBytes(&byte, 1, 1);
+      raw |= static_cast<uint64_t>(byte & 0x7F) << shift;
+      if ((byte & 0x80) == 0) {
+        break;
+      }
+    }
+  }
+  return raw;
+}
+
+template <typename Serializer>
+inline void writeVarint(Serializer& s, uint64_t raw) {
+  if (s.isSizing()) {
+    Serializer::contiguousTyped(
+      s, static_cast<SerialByteType*>(nullptr), varintLength(raw)
+    );
+  } else {
+    SerialByteType bytes[max_varint_bytes];
+    Serializer::contiguousTyped(s, bytes, encodeVarint(raw, bytes));
+  }
+}
+
+/*
+ * An integer that shrinks to a LEB128 varint (zigzag for signed types) when
+ * the serializer is in compact wire mode; fixed-width otherwise
+ */
+template <typename Serializer, typename IntT>
+inline void serializeVarint(Serializer& s, IntT& val) {
+  static_assert(std::is_integral<IntT>::value, "Varints must be integral");
+
+  if (not s.isCompact()) {
+    s | val;
+  } else if (s.isUnpacking()) {
+    val = fromVarintRaw<IntT>(readVarint(s));
+  } else {
+    writeVarint(s, toVarintRaw(val));
+  }
+}
+
+/*
+ * An array of integers as varints in compact wire mode: the encoded byte
+ * length followed by the varints, so unpacking decodes in one bounded batch
+ */
+template <typename Serializer, typename IntT>
+inline void serializeVarintArray(Serializer& s, IntT* arr, SerialSizeType num) {
+  static_assert(std::is_integral<IntT>::value, "Varints must be integral");
+
+  if (not s.isCompact()) {
+    serializeArray(s, arr, num);
+    return;
+  }
+
+  if (s.isUnpacking()) {
+    auto len = static_cast<SerialSizeType>(readVarint(s));
+    assert(len <= s.getRemaining() && "Varint array overruns the buffer");
+    len = std::min(len, s.getRemaining());
+
+    bool decoded = false;
+    auto const spot = s.getSpotIncrement(len);
+    if (spot != nullptr) {
+      decoded = decodeVarintBatch(spot, len, arr, num);
+    } else {
+      std::vector<SerialByteType> bytes(len);
+      s.contiguousBytes(bytes.data(), 1, len);
+      decoded = decodeVarintBatch(bytes.data(), len, arr, num);
+    }
+    assert(decoded && "Truncated varint array");
+    (void)decoded;
+    return;
+  }
+
+  SerialSizeType len = 0;
+  for (SerialSizeType i = 0; i < num; i++) {
+    len += varintLength(toVarintRaw(arr[i]));
+  }
+  writeVarint(s, len);
+
+  if (s.isSizing()) {
+    Serializer::contiguousTyped(s, static_cast<SerialByteType*>(nullptr), len);
+    return;
+  }
+
+  auto spot = s.getSpotIncrement(len);
+  if (spot != nullptr) {
+    for (SerialSizeType i = 0; i < num; i++) {
+      spot += encodeVarint(toVarintRaw(arr[i]), spot);
+    }
+  } else {
+    for (SerialSizeType i = 0; i < num; i++) {
+      writeVarint(s, toVarintRaw(arr[i]));
+    }
+  }
+}
+
+} /* end namespace serdes */
+
+#endif /*INCLUDED_SERDES_VARINT_SERIALIZE*/
@@ -47,7 +47,10 @@
 
 #include "serdes_common.h"
 #include "serializers/serializers_headers.h"
+#include "container_serialize.h"
 
+#include <cstring>
+#include <type_traits>
 #include <vector>
 
 namespace serdes {
@@ -55,16 +58,120 @@ namespace serdes {
 template <typename Serializer, typename T, typename VectorAllocator>
 void serializeVectorMeta(Serializer& s, std::vector<T, VectorAllocator>& vec) {
   SerialSizeType vec_size = vec.size();
-  s | vec_size;
+  serializeVarint(s, vec_size);
   vec.resize(vec_size);
 }
 
 template <typename Serializer, typename T, typename VectorAllocator>
-void serialize(Serializer& s, std::vector<T, VectorAllocator>& vec) {
+void unpackVector(
+  Serializer& s, std::vector<T, VectorAllocator>& vec, std::false_type
+) {
   serializeVectorMeta(s, vec);
   serializeArray(s, &vec[0], vec.size());
 }
 
+/*
+ * Byte-copyable elements are copy-constructed straight out of the buffer,
+ * avoiding the value-initialization pass that resize() would do first
+ */
+template <typename Serializer, typename T, typename VectorAllocator>
+void unpackVector(
+  Serializer& s, std::vector<T, VectorAllocator>& vec, std::true_type
+) {
+  SerialSizeType vec_size = 0;
+  serializeVarint(s, vec_size);
+
+  auto const spot = s.getSpotIncrement(vec_size * sizeof(T));
+  if (spot == nullptr) {
+    vec.resize(vec_size);
+    serializeArray(s, &vec[0], vec.size());
+  } else {
+    assignFromBytes<T>(vec, spot, vec_size);
+  }
+}
+
+template <typename Serializer, typename T, typename VectorAllocator>
+void serialize(Serializer& s, std::vector<T, VectorAllocator>& vec) {
+  if (s.isUnpacking()) {
+    unpackVector(s, vec, isByteCopyableElm<T>{});
+  } else {
+    serializeVectorMeta(s, vec);
+    serializeOwnedArray(s, &vec, vec.data(), vec.size());
+  }
+}
+
+template <typename Serializer, typename T, typename InnerAlloc, typename OuterAlloc>
+void serializeFlattenedPayload(
+  Serializer& s, std::vector<std::vector<T, InnerAlloc>, OuterAlloc>& vec,
+  std::vector<SerialSizeType> const& offsets, std::false_type
+) {
+  for (std::size_t i = 0; i < vec.size(); i++) {
+    if (s.isUnpacking()) {
+      vec[i].resize(offsets[i + 1] - offsets[i]);
+    }
+    serializeOwnedArray(s, &vec[i], vec[i].data(), vec[i].size());
+  }
+}
+
+template <typename Serializer, typename T, typename InnerAlloc, typename OuterAlloc>
+void serializeFlattenedPayload(
+  Serializer& s, std::vector<std::vector<T, InnerAlloc>, OuterAlloc>& vec,
+  std::vector<SerialSizeType> const& offsets, std::true_type
+) {
+  auto const spot = s.getSpotIncrement(offsets.back() * sizeof(T));
+  if (spot == nullptr) {
+    serializeFlattenedPayload(s, vec, offsets, std::false_type{});
+    return;
+  }
+
+  for (std::size_t i = 0; i < vec.size(); i++) {
+    auto const row = spot + offsets[i] * sizeof(T);
+    auto const len = offsets[i + 1] - offsets[i];
+    if (s.isUnpacking()) {
+      assignFromBytes<T>(vec[i], row, len);
+    } else if (len > 0) {
+      std::memcpy(row, vec[i].data(), len * sizeof(T));
+    }
+  }
+}
+
+/*
+ * Opt-in CSR-style encoding for jagged vectors: the row count, then a single
+ * offsets array (num_rows + 1 entries), then all rows concatenated into one
+ * contiguous payload. This replaces a size prefix and array call per row.
+ * The wire format differs from `s | vec`, so both sides must use this call.
+ */
+template <typename Serializer, typename T, typename InnerAlloc, typename OuterAlloc>
+void serializeFlattened(
+  Serializer& s, std::vector<std::vector<T, InnerAlloc>, OuterAlloc>& vec
+) {
+  SerialSizeType num_rows = vec.size();
+  serializeVarint(s, num_rows);
+
+  if (s.isSizing()) {
+    Serializer::contiguousTyped(
+      s, static_cast<SerialSizeType*>(nullptr), num_rows + 1
+    );
+    for (auto&& row : vec) {
+      serializeArray(s, row.data(), row.size());
+    }
+    return;
+  }
+
+  std::vector<SerialSizeType> offsets(num_rows + 1, 0);
+  if (s.isUnpacking()) {
+    vec.clear();
+    vec.resize(num_rows);
+  } else {
+    for (SerialSizeType i = 0; i < num_rows; i++) {
+      offsets[i + 1] = offsets[i] + vec[i].size();
+    }
+  }
+  serializeArray(s, offsets.data(), offsets.size());
+
+  serializeFlattenedPayload(s, vec, offsets, isByteCopyableElm<T>{});
+}
+
 template <typename Serializer, typename T, typename VectorAllocator>
 void parserdesVectorMeta(Serializer& s, std::vector<T, VectorAllocator>& vec) {
   SerialSizeType vec_size = vec.size();
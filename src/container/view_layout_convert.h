@@ -0,0 +1,230 @@
+/*
+//@HEADER
+// *****************************************************************************
+//
+//                            view_layout_convert.h
+//                           DARMA Toolkit v. 1.0.0
+//                 DARMA/checkpoint => Serialization Library
+//
+// Copyright 2019 National Technology & Engineering Solutions of Sandia, LLC
+// (NTESS). Under the terms of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the following disclaimer.
+//
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// * Neither the name of the copyright holder nor the names of its
+//   contributors may be used to endorse or promote products derived from this
+//   software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact darma@sandia.gov
+//
+// *****************************************************************************
+//@HEADER
+*/
+
+#if !defined INCLUDED_CONTAINER_VIEW_LAYOUT_CONVERT_H
+#define INCLUDED_CONTAINER_VIEW_LAYOUT_CONVERT_H
+
+#include "serdes_common.h"
+#include "serializers/serializers_headers.h"
+
+#if KOKKOS_ENABLED_SERDES
+
+#include <Kokkos_Core.hpp>
+#include <Kokkos_View.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <type_traits>
+
+// Edge length, in elements, of the tiles used when transposing on unpack
+#if !defined CHECKPOINT_KOKKOS_TRANSPOSE_TILE
+#define CHECKPOINT_KOKKOS_TRANSPOSE_TILE 32
+#endif
+
+namespace serdes {
+
+// Compact view headers tag the layout so a view can be unpacked into another
+// layout, transposing the packed data in tiles straight from the buffer
+
+enum struct eViewLayout : uint8_t {
+  Left = 0,
+  Right = 1,
+  Stride = 2
+};
+
+template <typename LayoutT>
+struct ViewLayoutTag;
+
+template <>
+struct ViewLayoutTag<Kokkos::LayoutLeft> {
+  static constexpr eViewLayout const value = eViewLayout::Left;
+};
+
+template <>
+struct ViewLayoutTag<Kokkos::LayoutRight> {
+  static constexpr eViewLayout const value = eViewLayout::Right;
+};
+
+template <>
+struct ViewLayoutTag<Kokkos::LayoutStride> {
+  static constexpr eViewLayout const value = eViewLayout::Stride;
+};
+
+using ViewDimArray = std::array<std::size_t, 8>;
+
+// Element strides of the packed data: dense, in the source's memory order
+inline ViewDimArray denseWireStrides(
+  eViewLayout src, int dim, ViewDimArray const& extent,
+  ViewDimArray const& src_stride
+) {
+  std::array<int, 8> order = {};
+  for (auto k = 0; k < dim; k++) {
+    order[k] = src == eViewLayout::Left ? dim - 1 - k : k;
+  }
+  if (src == eViewLayout::Stride) {
+    std::stable_sort(
+      order.begin(), order.begin() + dim,
+      [&](int a, int b) { return src_stride[a] > src_stride[b]; }
+    );
+  }
+
+  ViewDimArray wire_stride = {};
+  SerialSizeType acc = 1;
+  for (auto k = dim; k > 0; k--) {
+    wire_stride[order[k - 1]] = acc;
+    acc *= extent[order[k - 1]];
+  }
+  return wire_stride;
+}
+
+// Destination layout from the unpacked extents; LayoutStride takes wire strides
+template <typename LayoutT>
+inline LayoutT makeLayout(
+  int dim, ViewDimArray const& extent, ViewDimArray const&
+) {
+  LayoutT layout;
+  for (auto i = 0; i < dim; i++) {
+    layout.dimension[i] = extent[i];
+  }
+  return layout;
+}
+
+template <>
+inline Kokkos::LayoutStride makeLayout<Kokkos::LayoutStride>(
+  int dim, ViewDimArray const& extent, ViewDimArray const& stride
+) {
+  Kokkos::LayoutStride layout;
+  for (auto i = 0; i < dim; i++) {
+    layout.dimension[i] = extent[i];
+    layout.stride[i] = stride[i];
+  }
+  return layout;
+}
+
+// Copy packed bytes into `dst`, tiling the innermost source/destination dims
+template <typename T>
+inline void transposeFromBytes(
+  T* dst, ViewDimArray const& dst_stride, SerialByteType const* src,
+  ViewDimArray const& src_stride, ViewDimArray const& extent, int dim
+) {
+  if (dim == 0) {
+    std::memcpy(dst, src, sizeof(T));
+    return;
+  }
+  for (auto d = 0; d < dim; d++) {
+    if (extent[d] == 0) {
+      return;
+    }
+  }
+
+  auto const innermost = [&](ViewDimArray const& stride) {
+    auto best = 0;
+    for (auto d = 1; d < dim; d++) {
+      if (stride[d] < stride[best]) {
+        best = d;
+      }
+    }
+    return best;
+  };
+
+  auto const a = innermost(dst_stride);
+  auto const b = innermost(src_stride);
+
+  // With a common innermost dimension the "tile" degenerates to runs along a
+  SerialSizeType const ext_a = extent[a];
+  SerialSizeType const ext_b = a == b ? 1 : extent[b];
+  SerialSizeType const ds_a = dst_stride[a], ss_a = src_stride[a];
+  SerialSizeType const ds_b = a == b ? 0 : dst_stride[b];
+  SerialSizeType const ss_b = a == b ? 0 : src_stride[b];
+
+  std::array<int, 8> others = {};
+  auto num_others = 0;
+  for (auto d = 0; d < dim; d++) {
+    if (d != a and d != b) {
+      others[num_others++] = d;
+    }
+  }
+
+  SerialSizeType const tile = CHECKPOINT_KOKKOS_TRANSPOSE_TILE;
+  ViewDimArray idx = {};
+  for (;;) {
+    SerialSizeType dst_off = 0, src_off = 0;
+    for (auto k = 0; k < num_others; k++) {
+      dst_off += idx[k] * dst_stride[others[k]];
+      src_off += idx[k] * src_stride[others[k]];
+    }
+
+    for (SerialSizeType jb = 0; jb < ext_b; jb += tile) {
+      auto const j_end = std::min(jb + tile, ext_b);
+      for (SerialSizeType ib = 0; ib < ext_a; ib += tile) {
+        auto const i_end = std::min(ib + tile, ext_a);
+        for (SerialSizeType j = jb; j < j_end; j++) {
+          T* const to = dst + dst_off + j * ds_b;
+          auto const from = src + (src_off + j * ss_b) * sizeof(T);
+          for (SerialSizeType i = ib; i < i_end; i++) {
+            std::memcpy(to + i * ds_a, from + i * ss_a * sizeof(T), sizeof(T));
+          }
+        }
+      }
+    }
+
+    auto k = num_others;
+    for (; k > 0; k--) {
+      if (++idx[k - 1] < extent[others[k - 1]]) {
+        break;
+      }
+      idx[k - 1] = 0;
+    }
+    if (k == 0) {
+      return;
+    }
+  }
+}
+
+} /* end namespace serdes */
+
+#endif /*KOKKOS_ENABLED_SERDES*/
+
+#endif /*INCLUDED_CONTAINER_VIEW_LAYOUT_CONVERT_H*/
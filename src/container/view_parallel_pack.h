@@ -0,0 +1,186 @@
+/*
+//@HEADER
+// *****************************************************************************
+//
+//                             view_parallel_pack.h
+//                           DARMA Toolkit v. 1.0.0
+//                 DARMA/checkpoint => Serialization Library
+//
+// Copyright 2019 National Technology & Engineering Solutions of Sandia, LLC
+// (NTESS). Under the terms of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the following disclaimer.
+//
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// * Neither the name of the copyright holder nor the names of its
+//   contributors may be used to endorse or promote products derived from this
+//   software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact darma@sandia.gov
+//
+// *****************************************************************************
+//@HEADER
+*/
+
+#if !defined INCLUDED_CONTAINER_VIEW_PARALLEL_PACK_H
+#define INCLUDED_CONTAINER_VIEW_PARALLEL_PACK_H
+
+#include "serdes_common.h"
+#include "serializers/serializers_headers.h"
+#include "container/container_serialize.h"
+#include "container/view_traits_extract.h"
+#include "container/view_traverse_runs.h"
+
+#if KOKKOS_ENABLED_SERDES
+
+#include <Kokkos_Core.hpp>
+#include <Kokkos_View.hpp>
+
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+// Views whose payload is smaller than this are not worth a parallel launch
+#if !defined CHECKPOINT_KOKKOS_PARALLEL_PACK_MIN_BYTES
+#define CHECKPOINT_KOKKOS_PARALLEL_PACK_MIN_BYTES (1 << 20)
+#endif
+
+// Block size used to split the copy of a contiguous view across threads
+#if !defined CHECKPOINT_KOKKOS_PARALLEL_PACK_BLOCK_BYTES
+#define CHECKPOINT_KOKKOS_PARALLEL_PACK_BLOCK_BYTES (1 << 16)
+#endif
+
+namespace serdes {
+
+/*
+ * Pack or unpack a host-accessible view with Kokkos::parallel_for, producing
+ * the same bytes as the serial paths. apply() returns false and consumes
+ * nothing when the view does not qualify; the caller then packs serially.
+ */
+
+// Kokkos 3 declares concurrency() static and Kokkos 4 a member; calling it
+// through an instance compiles with both
+template <typename ExecSpace>
+inline int execConcurrency() {
+#if defined(KOKKOS_VERSION) && KOKKOS_VERSION >= 30000
+  return ExecSpace().concurrency();
+#else
+  return 1;
+#endif
+}
+
+template <typename ViewType>
+using ParallelPackableView = std::integral_constant<
+  bool,
+  isByteCopyableElm<typename CountDims<ViewType>::BaseT>::value and
+  Kokkos::SpaceAccessibility<
+    typename ViewType::execution_space, Kokkos::HostSpace
+  >::accessible and
+  Kokkos::SpaceAccessibility<
+    Kokkos::HostSpace, typename ViewType::memory_space
+  >::accessible
+>;
+
+template <
+  typename SerializerT, typename ViewType,
+  bool packable = ParallelPackableView<ViewType>::value
+>
+struct ParallelPack {
+  static bool apply(SerializerT&, ViewType const&, bool) { return false; }
+};
+
+template <typename SerializerT, typename ViewType>
+struct ParallelPack<SerializerT, ViewType, true> {
+  using BaseType = typename CountDims<ViewType>::BaseT;
+  using ExecSpace = typename ViewType::execution_space;
+  using IndexT = int64_t;
+  using PolicyType = Kokkos::RangePolicy<ExecSpace, Kokkos::IndexType<IndexT>>;
+
+  static bool apply(SerializerT& s, ViewType const& v, bool is_contig) {
+    SerialSizeType const num_elms = v.size();
+    SerialSizeType const num_bytes = num_elms * sizeof(BaseType);
+
+    if (
+      s.isSizing() or
+      num_bytes < CHECKPOINT_KOKKOS_PARALLEL_PACK_MIN_BYTES or
+      execConcurrency<ExecSpace>() < 2
+    ) {
+      return false;
+    }
+
+    auto const spot = s.getSpotIncrement(num_bytes);
+    if (spot == nullptr) {
+      return false;
+    }
+
+    bool const unpacking = s.isUnpacking();
+    auto const data = reinterpret_cast<SerialByteType*>(viewData(v));
+
+    if (is_contig) {
+      SerialSizeType const block = CHECKPOINT_KOKKOS_PARALLEL_PACK_BLOCK_BYTES;
+      auto const num_blocks = static_cast<IndexT>(
+        (num_bytes + block - 1) / block
+      );
+      Kokkos::parallel_for(
+        "checkpoint::pack_blocks", PolicyType(0, num_blocks),
+        [=](IndexT const b) {
+          auto const begin = static_cast<SerialSizeType>(b) * block;
+          auto const len = begin + block < num_bytes ? block : num_bytes - begin;
+          if (unpacking) {
+            std::memcpy(data + begin, spot + begin, len);
+          } else {
+            std::memcpy(spot + begin, data + begin, len);
+          }
+        }
+      );
+    } else {
+      auto const shape = makeRunShape(v);
+      SerialSizeType const run_bytes = shape.len * sizeof(BaseType);
+      BaseType* const base = viewData(v);
+
+      auto const num_runs = static_cast<IndexT>(shape.numRuns());
+      Kokkos::parallel_for(
+        "checkpoint::pack_runs", PolicyType(0, num_runs),
+        [=](IndexT const r) {
+          auto const run_index = static_cast<SerialSizeType>(r);
+          BaseType* const run = base + shape.runOffset(run_index);
+          SerialByteType* const dst = spot + run_index * run_bytes;
+          if (unpacking) {
+            scatterRun(run, dst, shape.len, shape.inner_stride);
+          } else {
+            gatherRun(dst, run, shape.len, shape.inner_stride);
+          }
+        }
+      );
+    }
+
+    ExecSpace().fence();
+    return true;
+  }
+};
+
+} /* end namespace serdes */
+
+#endif /*KOKKOS_ENABLED_SERDES*/
+
+#endif /*INCLUDED_CONTAINER_VIEW_PARALLEL_PACK_H*/
@@ -47,8 +47,15 @@
 
 #include "serdes_common.h"
 #include "serializers/serializers_headers.h"
+#include "container/container_serialize.h"
+#include "container/enum_serialize.h"
+#include "container/string_serialize.h"
+#include "container/varint_serialize.h"
 #include "container/view_traits_extract.h"
 #include "container/view_traverse_manual.h"
+#include "container/view_traverse_runs.h"
+#include "container/view_parallel_pack.h"
+#include "container/view_layout_convert.h"
 #include "container/view_traverse_ndim.h"
 
 #if KOKKOS_ENABLED_SERDES
@@ -58,12 +65,14 @@
 #include <Kokkos_DynamicView.hpp>
 #include <Kokkos_Serial.hpp>
 
+#include <algorithm>
 #include <array>
 #include <cassert>
 #include <tuple>
 #include <type_traits>
 #include <utility>
 #include <cstdio>
+#include <cstdlib>
 #include <tuple>
 #include <type_traits>
 
@@ -75,6 +84,18 @@
 // compiler versions
 #define CHECKPOINT_KOKKOS_NDIM_TRAVERSE 0
 
+// Compact wire mode: leave view labels out of the header altogether (unpacked
+// views are unlabeled) instead of interning them
+#if !defined CHECKPOINT_KOKKOS_COMPACT_OMIT_LABEL
+#define CHECKPOINT_KOKKOS_COMPACT_OMIT_LABEL 0
+#endif
+
+// Opt-in: pack and unpack large host views with Kokkos::parallel_for in the
+// view's execution space (see view_parallel_pack.h)
+#if !defined CHECKPOINT_KOKKOS_PARALLEL_PACK
+#define CHECKPOINT_KOKKOS_PARALLEL_PACK 0
+#endif
+
 #if SERDES_DEBUG_ENABLED
   #define DEBUG_PRINT_SERDES(ser, str, ...) do {                     \
       auto state = ser.isUnpacking() ? "Unpacking" : (               \
@@ -88,6 +109,32 @@
 
 namespace serdes {
 
+/*
+ * Allocation properties for re-constructed views. Every element of a view is
+ * overwritten when its data is unpacked, so views of byte-copyable elements
+ * are allocated without the initializing fill.
+ */
+
+template <typename ViewType, typename = void>
+struct ViewAllocProp {
+  static std::string apply(std::string const& label) { return label; }
+};
+
+template <typename T, typename... Args>
+struct ViewAllocProp<
+  Kokkos::View<T,Args...>,
+  std::enable_if_t<
+    isByteCopyableElm<
+      typename CountDims<Kokkos::View<T,Args...>>::BaseT
+    >::value
+  >
+>
+{
+  static auto apply(std::string const& label) {
+    return Kokkos::view_alloc(label, Kokkos::WithoutInitializing);
+  }
+};
+
 /*
  * Serialization factory re-constructors for views taking a parameter pack for
  * the constructor.
@@ -98,7 +145,7 @@ static ViewType buildView(
   std::string const& label, typename ViewType::pointer_type const val_ptr,
   I&&... index
 ) {
-  ViewType v{label, std::forward<I>(index)...};
+  ViewType v{ViewAllocProp<ViewType>::apply(label), std::forward<I>(index)...};
   return v;
 }
 
@@ -135,30 +182,101 @@ static constexpr ViewType constructView(
 template <typename SerdesT>
 inline void serializeLayout(SerdesT& s, int dim, Kokkos::LayoutStride& layout) {
   for (auto i = 0; i < dim; i++) {
-    s | layout.dimension[i];
-    s | layout.stride[i];
+    serializeVarint(s, layout.dimension[i]);
+    serializeVarint(s, layout.stride[i]);
   }
 }
 
 template <typename SerdesT>
 inline void serializeLayout(SerdesT& s, int dim, Kokkos::LayoutLeft& layout) {
   for (auto i = 0; i < dim; i++) {
-    s | layout.dimension[i];
+    serializeVarint(s, layout.dimension[i]);
   }
 }
 
 template <typename SerdesT>
 inline void serializeLayout(SerdesT& s, int dim, Kokkos::LayoutRight& layout) {
   for (auto i = 0; i < dim; i++) {
-    s | layout.dimension[i];
+    serializeVarint(s, layout.dimension[i]);
   }
 }
 
+template <typename ViewT>
+using KokkosConstArchetype = typename std::is_same<
+  typename ViewT::traits::const_data_type, typename ViewT::traits::data_type
+>;
+
+/*
+ * Re-construct a view being unpacked into. Const views are never unpacked
+ * into directly (see serialize_const), so there is nothing to construct.
+ */
+
+template <typename ViewType, typename Tuple>
+inline void reconstructView(
+  ViewType& view, std::string const& label, Tuple&& t, std::false_type
+) {
+  view = constructView<ViewType>(label, nullptr, std::forward<Tuple>(t));
+}
+
+template <typename ViewType, typename Tuple>
+inline void reconstructView(
+  ViewType&, std::string const&, Tuple&&, std::true_type
+) {
+  assert(false && "Const views must be unpacked through a non-const view");
+}
+
+/*
+ * Compare the serialized part of two layouts: an existing view whose layout
+ * matches the unpacked one already has the right shape
+ */
+
+inline bool sameLayout(
+  int dim, Kokkos::LayoutStride const& a, Kokkos::LayoutStride const& b
+) {
+  for (auto i = 0; i < dim; i++) {
+    if (a.dimension[i] != b.dimension[i] or a.stride[i] != b.stride[i]) {
+      return false;
+    }
+  }
+  return true;
+}
+
+template <typename LayoutT>
+inline bool sameLayout(int dim, LayoutT const& a, LayoutT const& b) {
+  for (auto i = 0; i < dim; i++) {
+    if (a.dimension[i] != b.dimension[i]) {
+      return false;
+    }
+  }
+  return true;
+}
+
+/*
+ * An existing view is unpacked into in place, keeping its allocation, only if
+ * it is allocated, not shared with another handle that would observe the
+ * overwrite, and carries the packed label
+ */
+template <typename ViewType>
+inline bool canReuseView(ViewType const& view, std::string const& label) {
+  return view.use_count() == 1 and view.label() == label;
+}
+
 template <typename SerializerT, typename ViewT>
 inline std::string serializeViewLabel(SerializerT& s, ViewT& view) {
-  // Serialize the label of the view
+  // Serialize the label of the view. Compact headers intern it in the
+  // per-message string table, or omit it entirely
   std::string view_label = view.label();
-  s | view_label;
+  if (not s.isCompact()) {
+    s | view_label;
+  } else {
+#if CHECKPOINT_KOKKOS_COMPACT_OMIT_LABEL
+    if (s.isUnpacking()) {
+      view_label.clear();
+    }
+#else
+    serializeInterned(s, view_label);
+#endif
+  }
 
   DEBUG_PRINT_SERDES(s, "serializeViewLabel: label=%s\n", view_label.c_str());
 
@@ -187,9 +305,9 @@ inline void serialize(
     view_size = view.size();
   }
 
-  s | chunk_size;
-  s | max_extent;
-  s | view_size;
+  serializeVarint(s, chunk_size);
+  serializeVarint(s, max_extent);
+  serializeVarint(s, view_size);
 
   DEBUG_PRINT_SERDES(
     s, "label=%s: chunk_size=%zu, max_extent=%zu, view_size=%zu\n",
@@ -210,32 +328,92 @@ inline void serialize(
 
   DEBUG_PRINT_SERDES(s, "label=%s: size=%zu\n", label.c_str(), view.size());
 
-  // Serialize the Kokkos::DynamicView data manually by traversing with
-  // DynamicView::operator()(...).
-  //
-  // @todo Optimize this by serializing by chunk
-  //
+  // Serialize the Kokkos::DynamicView data one allocated chunk at a time. The
+  // elements of a chunk are contiguous, so each chunk is a single bulk copy
+  // (and, on unpack, is filled in place right after resize_serial). The bytes
+  // are the same as traversing element by element.
+  std::size_t const view_chunk = view.chunk_size();
+  for (std::size_t begin = 0; begin < view_size; begin += view_chunk) {
+    auto const len = std::min(view_chunk, view_size - begin);
+    serializeArray(s, &view(begin), len);
+  }
+}
 
-#if CHECKPOINT_KOKKOS_NDIM_TRAVERSE
-    using CountDimType = CountDims<ViewType>;
-    using BaseType = typename CountDimType::BaseT;
+// Transpose unpacked bytes into a view whose layout differs from the packed one
+template <typename ViewType>
+inline void transposeIntoView(
+  ViewType& view, SerialByteType const* spot, ViewDimArray const& wire_stride,
+  ViewDimArray const& extent, int dim
+) {
+  ViewDimArray dst_stride = {};
+  for (auto i = 0; i < dim; i++) {
+    dst_stride[i] = view.stride(i);
+  }
+  transposeFromBytes(
+    viewData(view), dst_stride, spot, wire_stride, extent, dim
+  );
+}
 
-    auto fn = [&s](BaseType& elm){
-      s | elm;
-    };
+// Only byte-copyable elements have a fixed position in the packed buffer
+template <typename SerializerT, typename ViewType, typename IsConstT>
+inline void unpackConvertLayout(
+  SerializerT&, ViewType&, std::string const&, int, eViewLayout, IsConstT,
+  std::false_type
+) {
+  fprintf(stderr, "serdes: layout conversion needs byte-copyable elements\n");
+  std::abort();
+}
 
-    TraverseRecursive<ViewType,T,1,decltype(fn)>::apply(view,fn);
-#else
-    TraverseManual<SerializerT,ViewType,1>::apply(s,view);
-#endif
+// Unpack a view packed in another layout, transposing straight from the buffer
+template <typename SerializerT, typename ViewType, typename IsConstT>
+inline void unpackConvertLayout(
+  SerializerT& s, ViewType& view, std::string const& label, int rt_dim,
+  eViewLayout src, IsConstT is_const, std::true_type
+) {
+  using ArrayLayoutType = typename ViewType::traits::array_layout;
+  using BaseType = typename CountDims<ViewType>::BaseT;
+
+  // Read the layout data in the order serializeLayout wrote it for `src`
+  ViewDimArray extent = {};
+  ViewDimArray src_stride = {};
+  for (auto i = 0; i < rt_dim; i++) {
+    serializeVarint(s, extent[i]);
+    if (src == eViewLayout::Stride) {
+      serializeVarint(s, src_stride[i]);
+    }
+  }
+
+  auto const wire_stride = denseWireStrides(src, rt_dim, extent, src_stride);
+  auto const layout = makeLayout<ArrayLayoutType>(rt_dim, extent, wire_stride);
+  reconstructView(view, label, std::make_tuple(layout), is_const);
+
+  size_t num_elms = 0;
+  bool is_contig = false;
+  bool init = false;
+  serializeVarint(s, num_elms);
+  s | is_contig;
+  s | init;
+
+  DEBUG_PRINT_SERDES(
+    s, "label=%s: convert layout from %d, size=%zu, rt_dim=%d\n",
+    label.c_str(), static_cast<int>(src), num_elms, rt_dim
+  );
+
+  if (init) {
+    auto const spot = s.getSpotIncrement(num_elms * sizeof(BaseType));
+    if (spot == nullptr) {
+      fprintf(stderr, "serdes: layout conversion needs a memory unpacker\n");
+      std::abort();
+    }
+    transposeIntoView(view, spot, wire_stride, extent, rt_dim);
+  }
 }
 
 template <typename SerializerT, typename T, typename... Args>
 inline void serialize_impl(SerializerT& s, Kokkos::View<T,Args...>& view) {
   using ViewType = Kokkos::View<T,Args...>;
   using ArrayLayoutType = typename ViewType::traits::array_layout;
-
-  static constexpr auto const rank_val = ViewType::Rank;
+  using IsConstType = KokkosConstArchetype<ViewType>;
 
   assert(
     ViewType::traits::is_managed &&
@@ -251,9 +429,27 @@ inline void serialize_impl(SerializerT& s, Kokkos::View<T,Args...>& view) {
   if (!s.isUnpacking()) {
     rt_dim = CountDims<ViewType, T>::numDims(view);
   }
-  s | rt_dim;
+  serializeVarint(s, rt_dim);
 
 #if CHECKPOINT_KOKKOS_PACK_LAYOUT
+  // Compact headers tag the layout so the data can be unpacked into another
+  // layout; Fixed mode keeps the untagged format of existing checkpoints
+  auto layout_tag = ViewLayoutTag<ArrayLayoutType>::value;
+  if (s.isCompact()) {
+    serializeEnum(s, layout_tag);
+  }
+
+  bool const convert =
+    s.isUnpacking() and layout_tag != ViewLayoutTag<ArrayLayoutType>::value;
+  if (convert) {
+    using BaseType = typename CountDims<ViewType>::BaseT;
+    unpackConvertLayout(
+      s, view, label, rt_dim, layout_tag, IsConstType{},
+      isByteCopyableElm<BaseType>{}
+    );
+    return;
+  }
+
   // Serialize the Kokkos layout data, including the extents, strides
   ArrayLayoutType layout;
 
@@ -266,9 +462,14 @@ inline void serialize_impl(SerializerT& s, Kokkos::View<T,Args...>& view) {
     serializeLayout<SerializerT>(s, rt_dim, layout_cur);
   }
 
-  // Construct a view with the layout and use operator= to propagate out
+  // Construct a view with the layout and use operator= to propagate out,
+  // unless the current allocation already has this label and layout
   if (s.isUnpacking()) {
-    view = constructView<ViewType>(label, nullptr, std::make_tuple(layout));
+    bool const reuse =
+      canReuseView(view, label) and sameLayout(rt_dim, view.layout(), layout);
+    if (!reuse) {
+      reconstructView(view, label, std::make_tuple(layout), IsConstType{});
+    }
   }
 #else
   //
@@ -294,22 +495,37 @@ inline void serialize_impl(SerializerT& s, Kokkos::View<T,Args...>& view) {
     }
   }
 
-  s | extents_array;
+  for (auto i = 0; i < dyn_dims; i++) {
+    serializeVarint(s, extents_array[i]);
+  }
 
-  // Construct a view with the layout and use operator= to propagate out
+  // Construct a view with the layout and use operator= to propagate out,
+  // unless the current allocation already has this label and these extents
   if (s.isUnpacking()) {
-    view = constructView<ViewType>(label, nullptr, extents_array);
+    bool reuse = canReuseView(view, label);
+    for (auto i = 0; reuse and i < dyn_dims; i++) {
+      reuse = view.extent(i) == extents_array[i];
+    }
+    if (!reuse) {
+      reconstructView(view, label, extents_array, IsConstType{});
+    }
   }
 #endif
 
   // Serialize the total number of elements in the Kokkos::View
   size_t num_elms = view.size();
-  s | num_elms;
+  serializeVarint(s, num_elms);
 
   // Serialize whether the view is contiguous or not. Is this required?
   bool is_contig = view.span_is_contiguous();
   s | is_contig;
 
+  // Both paths put elements on the wire in the same order, so a reused
+  // receiver (possibly padded) is filled according to its own layout
+  if (s.isUnpacking()) {
+    is_contig = view.span_is_contiguous();
+  }
+
   DEBUG_PRINT_SERDES(
     s, "label=%s: contig=%s, size=%zu, rt_dim=%d\n",
     label.c_str(), is_contig ? "true" : "false", num_elms, rt_dim
@@ -322,12 +538,19 @@ inline void serialize_impl(SerializerT& s, Kokkos::View<T,Args...>& view) {
   s | init;
 
   if (init) {
+#if CHECKPOINT_KOKKOS_PARALLEL_PACK
+    if (ParallelPack<SerializerT,ViewType>::apply(s,view,is_contig)) {
+      return;
+    }
+#endif
+
     // Serialize the actual data owned by the Kokkos::View
     if (is_contig) {
       // Serialize the data directly out of the data buffer
-      serializeArray(s, view.data(), num_elms);
+      serializeArray(s, viewData(view), num_elms);
     } else {
-      // Serialize manually traversing the data with Kokkos::View::operator()(...)
+      // Serialize the data as runs along the innermost dimension in memory,
+      // visiting the view in its layout's memory order
 
 #if CHECKPOINT_KOKKOS_NDIM_TRAVERSE
       using CountDimType = CountDims<ViewType>;
@@ -340,7 +563,7 @@ inline void serialize_impl(SerializerT& s, Kokkos::View<T,Args...>& view) {
 
       TraverseRecursive<ViewType,T,dims,decltype(fn)>::apply(view,fn);
 #else
-      TraverseManual<SerializerT,ViewType,rank_val>::apply(s,view);
+      TraverseRuns<SerializerT,ViewType>::apply(s,view);
 #endif
     }
   }
@@ -350,21 +573,21 @@ template <typename SerializerT, typename T, typename... Args>
 inline void serialize_const(SerializerT& s, Kokkos::View<T,Args...>& view) {
   using ViewType = Kokkos::View<T,Args...>;
   using T_non_const = typename ViewType::traits::non_const_data_type;
-  Kokkos::View<T_non_const,Args...> tmp_non_const(view.label(), view.layout());
-  if (s.isPacking() || s.isSizing()) {
-    Kokkos::deep_copy(tmp_non_const, view);
+
+  // Sizing and packing only read the data, so they go straight through the
+  // const view without a temporary copy
+  if (!s.isUnpacking()) {
+    serialize_impl(s, view);
+    return;
   }
+
+  // Unpack into a non-const view (re-constructed by serialize_impl) and alias
+  // the result as const
+  Kokkos::View<T_non_const,Args...> tmp_non_const;
   serialize_impl(s, tmp_non_const);
-  if (s.isUnpacking()) {
-    view = tmp_non_const;
-  }
+  view = tmp_non_const;
 }
 
-template <typename ViewT>
-using KokkosConstArchetype = typename std::is_same<
-  typename ViewT::traits::const_data_type, typename ViewT::traits::data_type
->;
-
 template <typename ViewT, typename = void>
 struct SerializeConst;
 
@@ -402,7 +625,7 @@ template< typename SerializerT, typename T, typename... Ts >
 void serializeExtentOnly(SerializerT& s, Kokkos::View<T*,Ts...>& v, std::string label ) {
   // Pass label explicitly to reduce network transfer bytes
   auto view_extent_0 = v.extent(0);
-  s | view_extent_0;
+  serializeVarint(s, view_extent_0);
   if (s.isUnpacking()) {
     v = Kokkos::View<T*>(label, view_extent_0);
   }
@@ -413,7 +636,8 @@ void serializeExtentOnly(SerializerT& s, Kokkos::View<T**,Ts...>& v, std::string
   // Pass label explicitly to reduce network transfer bytes
   auto view_extent_0 = v.extent(0);
   auto view_extent_1 = v.extent(1);
-  s | view_extent_0 | view_extent_1;
+  serializeVarint(s, view_extent_0);
+  serializeVarint(s, view_extent_1);
   if (s.isUnpacking()) {
     v = Kokkos::View<T**>(label, view_extent_0, view_extent_1);
   }
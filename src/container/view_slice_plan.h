@@ -0,0 +1,244 @@
+/*
+//@HEADER
+// *****************************************************************************
+//
+//                              view_slice_plan.h
+//                           DARMA Toolkit v. 1.0.0
+//                 DARMA/checkpoint => Serialization Library
+//
+// Copyright 2019 National Technology & Engineering Solutions of Sandia, LLC
+// (NTESS). Under the terms of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the following disclaimer.
+//
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// * Neither the name of the copyright holder nor the names of its
+//   contributors may be used to endorse or promote products derived from this
+//   software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact darma@sandia.gov
+//
+// *****************************************************************************
+//@HEADER
+*/
+
+#if !defined INCLUDED_CONTAINER_VIEW_SLICE_PLAN_H
+#define INCLUDED_CONTAINER_VIEW_SLICE_PLAN_H
+
+#include "serdes_common.h"
+#include "serializers/serializers_headers.h"
+#include "container/container_serialize.h"
+#include "container/view_traits_extract.h"
+#include "container/view_traverse_runs.h"
+
+#if KOKKOS_ENABLED_SERDES
+
+#include <Kokkos_Core.hpp>
+#include <Kokkos_View.hpp>
+
+#include <cstring>
+#include <type_traits>
+#include <vector>
+
+namespace serdes {
+
+/*
+ * A packing plan for an ordered list of slices (subview ranges) of one or
+ * more views, e.g., the faces of a 3-D field sent to one neighbor in a halo
+ * exchange. The slices are packed back to back into one buffer with no
+ * metadata: the receiver builds the matching plan over its own views and
+ * unpacks symmetrically.
+ *
+ * Each slice is reduced once, when it is added, to runs along its innermost
+ * dimension in memory (see TraverseRuns); unit-stride runs that are adjacent
+ * in memory are merged, so a face that is contiguous in memory is a single
+ * memcpy. Like PackPlan, runs are kept by address: a plan is valid only while
+ * the views it was built from keep their allocations.
+ */
+struct ViewSlicePlan {
+  struct Run {
+    SerialByteType* base = nullptr;
+    SerialSizeType len = 0;       // elements
+    SerialSizeType stride = 1;    // elements
+    SerialSizeType elm_size = 0;  // bytes
+  };
+
+  SerialSizeType getSize() const { return size_; }
+  std::size_t getNumRuns() const { return runs_.size(); }
+  bool empty() const { return runs_.empty(); }
+
+  void clear() {
+    runs_.clear();
+    size_ = 0;
+  }
+
+  /*
+   * Append the slice of `view` selected by `args`, given as for
+   * Kokkos::subview: one Kokkos::pair, Kokkos::ALL or index per dimension
+   */
+  template <typename ViewType, typename... ArgsT>
+  void addSlice(ViewType const& view, ArgsT&&... args) {
+    auto const sub = Kokkos::subview(view, std::forward<ArgsT>(args)...);
+    using SubViewType = std::decay_t<decltype(sub)>;
+    using BaseType = typename CountDims<SubViewType>::BaseT;
+    using ShapeType = ViewRunShape<SubViewType::Rank>;
+
+    static_assert(
+      isByteCopyableElm<BaseType>::value,
+      "Slices must have byte-copyable elements"
+    );
+    static_assert(
+      Kokkos::SpaceAccessibility<
+        Kokkos::HostSpace, typename SubViewType::memory_space
+      >::accessible,
+      "Slices must be host-accessible"
+    );
+
+    if (sub.size() == 0) {
+      return;
+    }
+
+    auto const shape = makeRunShape(sub);
+    BaseType* const base = viewData(sub);
+    auto fn = [&](SerialSizeType const offset) {
+      appendRun(
+        reinterpret_cast<SerialByteType*>(base + offset), shape.len,
+        shape.inner_stride, sizeof(BaseType)
+      );
+    };
+    RunNest<0, ShapeType::outer>::apply(shape, 0, fn);
+  }
+
+  void pack(SerialByteType* buf) const {
+    for (auto&& run : runs_) {
+      if (run.stride == 1) {
+        std::memcpy(buf, run.base, run.len * run.elm_size);
+      } else {
+        auto const step = run.stride * run.elm_size;
+        for (SerialSizeType k = 0; k < run.len; k++) {
+          std::memcpy(
+            buf + k * run.elm_size, run.base + k * step, run.elm_size
+          );
+        }
+      }
+      buf += run.len * run.elm_size;
+    }
+  }
+
+  void unpack(SerialByteType const* buf) const {
+    for (auto&& run : runs_) {
+      if (run.stride == 1) {
+        std::memcpy(run.base, buf, run.len * run.elm_size);
+      } else {
+        auto const step = run.stride * run.elm_size;
+        for (SerialSizeType k = 0; k < run.len; k++) {
+          std::memcpy(
+            run.base + k * step, buf + k * run.elm_size, run.elm_size
+          );
+        }
+      }
+      buf += run.len * run.elm_size;
+    }
+  }
+
+  // Hand each run to a serializer that has no memory cursor
+  template <typename SerializerT>
+  void serializeRuns(SerializerT& s) const {
+    for (auto&& run : runs_) {
+      if (run.stride == 1) {
+        s.contiguousBytes(run.base, run.elm_size, run.len);
+      } else {
+        auto const step = run.stride * run.elm_size;
+        for (SerialSizeType k = 0; k < run.len; k++) {
+          s.contiguousBytes(run.base + k * step, run.elm_size, 1);
+        }
+      }
+    }
+  }
+
+private:
+  void appendRun(
+    SerialByteType* base, SerialSizeType len, SerialSizeType stride,
+    SerialSizeType elm_size
+  ) {
+    if (len == 1) {
+      stride = 1;
+    }
+
+    // Merge with the previous run when both are unit-stride and adjacent
+    if (stride == 1 and not runs_.empty()) {
+      auto& last = runs_.back();
+      if (
+        last.stride == 1 and last.elm_size == elm_size and
+        last.base + last.len * elm_size == base
+      ) {
+        last.len += len;
+        size_ += len * elm_size;
+        return;
+      }
+    }
+
+    Run run;
+    run.base = base;
+    run.len = len;
+    run.stride = stride;
+    run.elm_size = elm_size;
+    runs_.push_back(run);
+    size_ += len * elm_size;
+  }
+
+private:
+  std::vector<Run> runs_;
+  SerialSizeType size_ = 0;
+};
+
+/*
+ * Serialize the slices of a plan as one block of getSize() bytes, so a halo
+ * message can be composed with other serialized data. Slices hold only
+ * element bytes, never interned strings, so they do not touch the table.
+ */
+template <typename SerializerT>
+inline void serializeSlices(SerializerT& s, ViewSlicePlan const& plan) {
+  auto const size = plan.getSize();
+  if (s.isSizing()) {
+    SerializerT::contiguousTyped(
+      s, static_cast<SerialByteType*>(nullptr), size
+    );
+    return;
+  }
+
+  auto const spot = s.getSpotIncrement(size);
+  if (spot == nullptr) {
+    plan.serializeRuns(s);
+  } else if (s.isUnpacking()) {
+    plan.unpack(spot);
+  } else {
+    plan.pack(spot);
+  }
+}
+
+} /* end namespace serdes */
+
+#endif /*KOKKOS_ENABLED_SERDES*/
+
+#endif /*INCLUDED_CONTAINER_VIEW_SLICE_PLAN_H*/
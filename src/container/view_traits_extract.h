@@ -112,6 +112,18 @@ struct CountDims<ViewType, T[N]> {
   }
 };
 
+/*
+ * The data pointer of a view as a mutable pointer to its base type. Const
+ * views are only read through it (sizing and packing). For atomic views it is
+ * the raw storage: bulk copies through it are valid only while the view is
+ * quiescent, as for any serialization of the view.
+ */
+template <typename ViewType>
+inline typename CountDims<ViewType>::BaseT* viewData(ViewType const& view) {
+  using BaseType = typename CountDims<ViewType>::BaseT;
+  return const_cast<BaseType*>(static_cast<BaseType const*>(view.data()));
+}
+
 } /* end namespace serdes */
 
 #endif /*KOKKOS_ENABLED_SERDES*/
@@ -0,0 +1,269 @@
+/*
+//@HEADER
+// *****************************************************************************
+//
+//                             view_traverse_runs.h
+//                           DARMA Toolkit v. 1.0.0
+//                 DARMA/checkpoint => Serialization Library
+//
+// Copyright 2019 National Technology & Engineering Solutions of Sandia, LLC
+// (NTESS). Under the terms of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the following disclaimer.
+//
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// * Neither the name of the copyright holder nor the names of its
+//   contributors may be used to endorse or promote products derived from this
+//   software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact darma@sandia.gov
+//
+// *****************************************************************************
+//@HEADER
+*/
+
+#if !defined INCLUDED_CONTAINER_VIEW_TRAVERSE_RUNS_H
+#define INCLUDED_CONTAINER_VIEW_TRAVERSE_RUNS_H
+
+#include "serdes_common.h"
+#include "serializers/serializers_headers.h"
+#include "container/container_serialize.h"
+#include "container/view_traits_extract.h"
+
+#if KOKKOS_ENABLED_SERDES
+
+#include <Kokkos_Core.hpp>
+#include <Kokkos_View.hpp>
+
+#include <array>
+#include <cstring>
+#include <type_traits>
+
+namespace serdes {
+
+/*
+ * Serializes a non-contiguous view of any rank as runs along its innermost
+ * dimension in memory, visiting the outer dimensions in memory order
+ */
+
+/*
+ * Shape of a view as runs: the outer dimensions in memory order (outermost
+ * first) plus the length and stride of the innermost dimension
+ */
+template <std::size_t rank>
+struct ViewRunShape {
+  static constexpr std::size_t outer = rank > 1 ? rank - 1 : 0;
+
+  std::array<SerialSizeType, outer + 1> extent = {};
+  std::array<SerialSizeType, outer + 1> stride = {};
+  SerialSizeType len = 1;
+  SerialSizeType inner_stride = 1;
+
+  SerialSizeType numRuns() const {
+    SerialSizeType num = 1;
+    for (std::size_t d = 0; d < outer; d++) {
+      num *= extent[d];
+    }
+    return num;
+  }
+
+  // Element offset of the r-th run in traversal order
+  SerialSizeType runOffset(SerialSizeType r) const {
+    SerialSizeType offset = 0;
+    for (std::size_t d = outer; d > 0; d--) {
+      offset += (r % extent[d - 1]) * stride[d - 1];
+      r /= extent[d - 1];
+    }
+    return offset;
+  }
+};
+
+// A rank-0 view is a single run of one element
+template <typename ViewType>
+inline ViewRunShape<0> makeRunShape(ViewType const&, std::true_type) {
+  return ViewRunShape<0>{};
+}
+
+template <typename ViewType>
+inline ViewRunShape<ViewType::Rank> makeRunShape(
+  ViewType const& v, std::false_type
+) {
+  using LayoutType = typename ViewType::traits::array_layout;
+  using ShapeType = ViewRunShape<ViewType::Rank>;
+
+  static constexpr std::size_t rank = ViewType::Rank;
+  static_assert(rank >= 1 and rank <= 8, "Kokkos views have 1 to 8 dimensions");
+
+  // Start from the layout's natural order and stable-sort by decreasing
+  // stride; only a LayoutStride can actually be reordered by this
+  bool const left = std::is_same<LayoutType, Kokkos::LayoutLeft>::value;
+  std::array<std::size_t, rank> order = {};
+  for (std::size_t k = 0; k < rank; k++) {
+    order[k] = left ? rank - 1 - k : k;
+  }
+  for (std::size_t k = 1; k < rank; k++) {
+    auto const d = order[k];
+    auto j = k;
+    for (; j > 0 and v.stride(order[j - 1]) < v.stride(d); j--) {
+      order[j] = order[j - 1];
+    }
+    order[j] = d;
+  }
+
+  ShapeType shape;
+  for (std::size_t k = 0; k < ShapeType::outer; k++) {
+    shape.extent[k] = v.extent(order[k]);
+    shape.stride[k] = v.stride(order[k]);
+  }
+  shape.len = v.extent(order[rank - 1]);
+  shape.inner_stride = v.stride(order[rank - 1]);
+  return shape;
+}
+
+template <typename ViewType>
+inline ViewRunShape<ViewType::Rank> makeRunShape(ViewType const& v) {
+  return makeRunShape(v, std::integral_constant<bool, ViewType::Rank == 0>{});
+}
+
+/*
+ * Compile-time loop nest over the outer dimensions of a ViewRunShape, calling
+ * fn(offset) for each run in traversal order
+ */
+template <std::size_t level, std::size_t outer>
+struct RunNest {
+  template <typename ShapeT, typename FnT>
+  static void apply(ShapeT const& shape, SerialSizeType offset, FnT& fn) {
+    for (SerialSizeType i = 0; i < shape.extent[level]; i++) {
+      RunNest<level + 1, outer>::apply(
+        shape, offset + i * shape.stride[level], fn
+      );
+    }
+  }
+};
+
+template <std::size_t outer>
+struct RunNest<outer, outer> {
+  template <typename ShapeT, typename FnT>
+  static void apply(ShapeT const&, SerialSizeType offset, FnT& fn) {
+    fn(offset);
+  }
+};
+
+template <typename T>
+inline void gatherRun(
+  SerialByteType* dst, T const* src, SerialSizeType len, SerialSizeType stride
+) {
+  if (stride == 1) {
+    std::memcpy(dst, src, len * sizeof(T));
+  } else {
+    for (SerialSizeType k = 0; k < len; k++) {
+      std::memcpy(dst + k * sizeof(T), src + k * stride, sizeof(T));
+    }
+  }
+}
+
+template <typename T>
+inline void scatterRun(
+  T* dst, SerialByteType const* src, SerialSizeType len, SerialSizeType stride
+) {
+  if (stride == 1) {
+    std::memcpy(dst, src, len * sizeof(T));
+  } else {
+    for (SerialSizeType k = 0; k < len; k++) {
+      std::memcpy(dst + k * stride, src + k * sizeof(T), sizeof(T));
+    }
+  }
+}
+
+template <typename SerializerT, typename ViewType>
+struct TraverseRuns {
+  using BaseType = typename CountDims<ViewType>::BaseT;
+  using ShapeType = ViewRunShape<ViewType::Rank>;
+  using NestType = RunNest<0, ShapeType::outer>;
+
+  static void apply(SerializerT& s, ViewType const& v) {
+    if (v.size() == 0) {
+      return;
+    }
+
+    apply(s, v, makeRunShape(v), isByteCopyableElm<BaseType>{});
+  }
+
+private:
+  static void apply(
+    SerializerT& s, ViewType const& v, ShapeType const& shape, std::true_type
+  ) {
+    SerialSizeType const num_elms = v.size();
+    BaseType* const base = viewData(v);
+
+    if (s.isSizing()) {
+      SerializerT::contiguousTyped(s, base, num_elms);
+      return;
+    }
+
+    auto const spot = s.getSpotIncrement(num_elms * sizeof(BaseType));
+    if (spot == nullptr) {
+      apply(s, v, shape, std::false_type{});
+      return;
+    }
+
+    auto const run_bytes = shape.len * sizeof(BaseType);
+    auto cur = spot;
+    if (s.isUnpacking()) {
+      auto fn = [&](SerialSizeType const offset) {
+        scatterRun(base + offset, cur, shape.len, shape.inner_stride);
+        cur += run_bytes;
+      };
+      NestType::apply(shape, 0, fn);
+    } else {
+      auto fn = [&](SerialSizeType const offset) {
+        gatherRun(cur, base + offset, shape.len, shape.inner_stride);
+        cur += run_bytes;
+      };
+      NestType::apply(shape, 0, fn);
+    }
+  }
+
+  static void apply(
+    SerializerT& s, ViewType const& v, ShapeType const& shape, std::false_type
+  ) {
+    BaseType* const base = viewData(v);
+    auto fn = [&](SerialSizeType const offset) {
+      BaseType* const run = base + offset;
+      if (shape.inner_stride == 1) {
+        serializeArray(s, run, shape.len);
+      } else {
+        for (SerialSizeType k = 0; k < shape.len; k++) {
+          s | run[k * shape.inner_stride];
+        }
+      }
+    };
+    NestType::apply(shape, 0, fn);
+  }
+};
+
+} /* end namespace serdes */
+
+#endif /*KOKKOS_ENABLED_SERDES*/
+
+#endif /*INCLUDED_CONTAINER_VIEW_TRAVERSE_RUNS_H*/
@@ -58,11 +58,17 @@ namespace serdes {
 
 struct InPlaceTag { };
 
+// Bytes in front of a payload produced by serializeTypeWithMode
+static constexpr SerialSizeType const wire_header_size = 1;
+
 template <typename T>
 struct Dispatch {
-  static SerialSizeType sizeType(T& to_size);
+  static SerialSizeType sizeType(
+    T& to_size, eWireMode mode = eWireMode::Fixed
+  );
   static BufferPtrType packType(
-    T& to_pack, SerialSizeType const& size, SerialByteType* buf
+    T& to_pack, SerialSizeType const& size, SerialByteType* buf,
+    eWireMode mode = eWireMode::Fixed
   );
   template <typename PackerT>
   static BufferPtrType packTypeWithPacker(
@@ -70,7 +76,7 @@ struct Dispatch {
   );
   static T& unpackType(
     SerialByteType* buf, SerialByteType* data, SerialSizeType const& size,
-    bool in_place = false
+    bool in_place = false, eWireMode mode = eWireMode::Fixed
   );
 
   static SerialSizeType sizeTypePartial(T& to_size);
@@ -95,6 +101,15 @@ inline Serializer& operator&(Serializer& s, T& target);
 template <typename Serializer, typename T>
 inline void serializeArray(Serializer& s, T* array, SerialSizeType const num_elms);
 
+/*
+ * serializeArray over storage owned by `owner`, such as a container's heap
+ * buffer; lets a PlanRecorder keep a reference to it instead of a copy
+ */
+template <typename Serializer, typename T>
+inline void serializeOwnedArray(
+  Serializer& s, void const* owner, T* array, SerialSizeType const num_elms
+);
+
 template <typename Serializer, typename T>
 inline void parserdesArray(Serializer& s, T* array, SerialSizeType const num_elms);
 
@@ -108,6 +123,21 @@ T* deserializeType(
   SerialByteType* data, SerialSizeType const& size, T* allocBuf = nullptr
 );
 
+/*
+ * Serialize with the wire mode chosen per call; the mode is recorded in a
+ * one-byte header so deserializeTypeWithMode can decode either encoding. The
+ * latter returns nullptr if the header names an unknown mode.
+ */
+template <typename T>
+SerializedReturnType serializeTypeWithMode(
+  T& to_serialize, eWireMode mode, BufferObtainFnType fn = nullptr
+);
+
+template <typename T>
+T* deserializeTypeWithMode(
+  SerialByteType* data, SerialSizeType const& size, T* allocBuf = nullptr
+);
+
 template <typename T>
 void deserializeType(InPlaceTag, SerialByteType* data, SerialSizeType sz, T* t);
 
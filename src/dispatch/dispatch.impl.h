@@ -51,12 +51,17 @@
 namespace serdes {
 
 template <typename T>
-SerialSizeType Dispatch<T>::sizeType(T& to_size) {
+SerialSizeType Dispatch<T>::sizeType(T& to_size, eWireMode mode) {
   using DispatchT = DispatchCommon<T>;
   using CleanT = typename DispatchT::CleanT;
   auto val = DispatchT::clean(&to_size);
 
+  StringTable table;
   Sizer sizer;
+  sizer.setWireMode(mode);
+  if (mode == eWireMode::Compact) {
+    sizer.setStringTable(&table);
+  }
   SerializerDispatch<Sizer, CleanT> ap;
   ap(sizer, val, 1);
   return sizer.getSize();
@@ -78,13 +83,19 @@ BufferPtrType Dispatch<T>::packTypeWithPacker(
 
 template <typename T>
 BufferPtrType Dispatch<T>::packType(
-  T& to_pack, SerialSizeType const& size, SerialByteType* buf
+  T& to_pack, SerialSizeType const& size, SerialByteType* buf, eWireMode mode
 ) {
+  StringTable table;
+  auto const table_ptr = mode == eWireMode::Compact ? &table : nullptr;
   if (buf == nullptr) {
     Packer packer(size);
+    packer.setWireMode(mode);
+    packer.setStringTable(table_ptr);
     return packTypeWithPacker(packer, to_pack, size);
   } else {
     PackerUserBuf packer(size, std::make_unique<UserBuffer>(buf, size));
+    packer.setWireMode(mode);
+    packer.setStringTable(table_ptr);
     return packTypeWithPacker(packer, to_pack, size);
   }
 }
@@ -92,12 +103,17 @@ BufferPtrType Dispatch<T>::packType(
 template <typename T>
 T& Dispatch<T>::unpackType(
   SerialByteType* buf, SerialByteType* data, SerialSizeType const& size,
-  bool in_place
+  bool in_place, eWireMode mode
 ) {
   using DispatchT = DispatchCommon<T>;
   using CleanT = typename DispatchT::CleanT;
 
+  StringTable table;
   Unpacker unpacker(data, size);
+  unpacker.setWireMode(mode);
+  if (mode == eWireMode::Compact) {
+    unpacker.setStringTable(&table);
+  }
   if (in_place) {
     auto t_buf = reinterpret_cast<T*>(buf);
     SerializerDispatch<Unpacker, CleanT> ap;
@@ -202,6 +218,14 @@ inline void serializeArray(Serializer& s, T* array, SerialSizeType const num_elm
   ap(s, val, num_elms);
 }
 
+template <typename Serializer, typename T>
+inline void serializeOwnedArray(
+  Serializer& s, void const* owner, T* array, SerialSizeType const num_elms
+) {
+  s.addOwnedStorage(owner, array, num_elms * sizeof(T));
+  serializeArray(s, array, num_elms);
+}
+
 template <typename Serializer, typename T>
 inline void parserdesArray(Serializer& s, T* array, SerialSizeType const num_elms) {
   using DispatchT = DispatchCommon<T>;
@@ -254,6 +278,45 @@ T* deserializeType(
   return &t;
 }
 
+template <typename T>
+SerializedReturnType serializeTypeWithMode(
+  T& to_serialize, eWireMode mode, BufferObtainFnType fn
+) {
+  SerialSizeType size = wire_header_size + Dispatch<T>::sizeType(to_serialize, mode);
+  SerialByteType* user_buf = fn ? fn(size) : nullptr;
+  BufferPtrType managed = user_buf ?
+    BufferPtrType(std::make_unique<UserBuffer>(user_buf, size)) :
+    BufferPtrType(std::make_unique<ManagedBuffer>(size));
+
+  // The header byte goes in front; the payload is packed right behind it
+  auto const buf = managed->getBuffer();
+  buf[0] = static_cast<SerialByteType>(mode);
+  Dispatch<T>::packType(
+    to_serialize, size - wire_header_size, buf + wire_header_size, mode
+  );
+  return std::make_tuple(std::move(managed), size);
+}
+
+template <typename T>
+T* deserializeTypeWithMode(
+  SerialByteType* data, SerialSizeType const& size, T* allocBuf
+) {
+  if (size < wire_header_size) {
+    return nullptr;
+  }
+  auto const mode = static_cast<eWireMode>(data[0]);
+  if (mode != eWireMode::Fixed and mode != eWireMode::Compact) {
+    return nullptr;
+  }
+
+  auto mem = allocBuf ?
+    reinterpret_cast<SerialByteType*>(allocBuf) : new SerialByteType[sizeof(T)];
+  auto& t = Dispatch<T>::unpackType(
+    mem, data + wire_header_size, size - wire_header_size, false, mode
+  );
+  return &t;
+}
+
 template <typename T>
 void deserializeType(InPlaceTag, SerialByteType* data, SerialSizeType sz, T* t) {
   auto t_place = reinterpret_cast<SerialByteType*>(t);
@@ -0,0 +1,152 @@
+/*
+//@HEADER
+// *****************************************************************************
+//
+//                              dispatch_fields.h
+//                           DARMA Toolkit v. 1.0.0
+//                 DARMA/checkpoint => Serialization Library
+//
+// Copyright 2019 National Technology & Engineering Solutions of Sandia, LLC
+// (NTESS). Under the terms of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the following disclaimer.
+//
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// * Neither the name of the copyright holder nor the names of its
+//   contributors may be used to endorse or promote products derived from this
+//   software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact darma@sandia.gov
+//
+// *****************************************************************************
+//@HEADER
+*/
+
+#if ! defined INCLUDED_SERDES_DISPATCH_FIELDS
+#define INCLUDED_SERDES_DISPATCH_FIELDS
+
+#include "serdes_common.h"
+#include "serdes_all.h"
+#include "traits/field_list.h"
+#include "traits/serializable_traits.h"
+
+#include <cstdlib>
+#include <type_traits>
+
+namespace serdes {
+
+/*
+ * Serialize a type through its declared member list (SERDES_FIELDS). Walking
+ * the list at compile time, consecutive byte-copyable members that abut in
+ * memory (no padding between them) are merged into a run that moves with a
+ * single fixed-size contiguousBytes call. Other members go through `s | m`.
+ * The bytes produced are identical to serializing each member in turn.
+ */
+template <
+  typename SerializerT, typename T, std::size_t RunOffset, std::size_t RunSize,
+  typename ListT
+>
+struct CoalescedFields;
+
+template <
+  typename SerializerT, typename T, std::size_t RunOffset, std::size_t RunSize
+>
+struct CoalescedFields<SerializerT, T, RunOffset, RunSize, FieldList<>> {
+  static void flush(SerializerT& s, T& t, std::true_type) {
+    auto const run = reinterpret_cast<SerialByteType*>(&t) + RunOffset;
+    SerializerT::contiguousTyped(s, run, RunSize);
+  }
+
+  static void flush(SerializerT&, T&, std::false_type) { }
+
+  static void apply(SerializerT& s, T& t) {
+    flush(s, t, std::integral_constant<bool, (RunSize > 0)>{});
+  }
+};
+
+template <
+  typename SerializerT, typename T, std::size_t RunOffset, std::size_t RunSize,
+  typename FieldT, typename... Rest
+>
+struct CoalescedFields<
+  SerializerT, T, RunOffset, RunSize, FieldList<FieldT, Rest...>
+> {
+  using MemberT = typename FieldT::MemberType;
+
+  static constexpr bool const is_bytes =
+    #if HAS_DETECTION_COMPONENT
+      SerializableTraits<MemberT>::is_bytecopyable;
+    #else
+      std::is_arithmetic<MemberT>::value;
+    #endif
+
+  static constexpr bool const extends_run =
+    is_bytes and RunSize > 0 and RunOffset + RunSize == FieldT::offset;
+
+  using FlushT = CoalescedFields<SerializerT, T, RunOffset, RunSize, FieldList<>>;
+
+  // Member is adjacent to the current run: grow the run
+  static void step(SerializerT& s, T& t, std::true_type, std::true_type) {
+    CoalescedFields<
+      SerializerT, T, RunOffset, RunSize + FieldT::size, FieldList<Rest...>
+    >::apply(s, t);
+  }
+
+  // Byte-copyable but not adjacent: close the run and start a new one here
+  static void step(SerializerT& s, T& t, std::true_type, std::false_type) {
+    FlushT::apply(s, t);
+    CoalescedFields<
+      SerializerT, T, FieldT::offset, FieldT::size, FieldList<Rest...>
+    >::apply(s, t);
+  }
+
+  // Not byte-copyable: close the run and dispatch the member normally
+  static void step(SerializerT& s, T& t, std::false_type, std::false_type) {
+    FlushT::apply(s, t);
+    s | FieldT::get(t);
+    CoalescedFields<SerializerT, T, 0, 0, FieldList<Rest...>>::apply(s, t);
+  }
+
+  static void apply(SerializerT& s, T& t) {
+    step(
+      s, t, std::integral_constant<bool, is_bytes>{},
+      std::integral_constant<bool, extends_run>{}
+    );
+  }
+};
+
+template <typename SerializerT, typename T, typename... FieldsT>
+inline void serializeFields(
+  SerializerT& s, T& t, FieldList<FieldsT...> const&
+) {
+  CoalescedFields<SerializerT, T, 0, 0, FieldList<FieldsT...>>::apply(s, t);
+}
+
+template <typename SerializerT, typename T>
+inline void serializeFields(SerializerT& s, T& t) {
+  serializeFields(s, t, Fields<T>{});
+}
+
+} /* end namespace serdes */
+
+#endif /*INCLUDED_SERDES_DISPATCH_FIELDS*/
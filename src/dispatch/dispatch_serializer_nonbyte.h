@@ -48,6 +48,7 @@
 #include "serdes_common.h"
 #include "serdes_all.h"
 #include "traits/serializable_traits.h"
+#include "dispatch_fields.h"
 
 #include <type_traits>
 #include <tuple>
@@ -180,6 +181,10 @@ struct SerializerDispatchNonByte {
     using hasNoninSerialize =
     typename std::enable_if<SerializableTraits<U>::has_serialize_noninstrusive, T>::type;
 
+    template <typename U>
+    using hasFieldsSerialize =
+    typename std::enable_if<SerializableTraits<U>::has_fields_serialize, T>::type;
+
     template <typename U>
     using isEnum =
     typename std::enable_if<std::is_enum<U>::value, T>::type;
@@ -216,15 +221,62 @@ struct SerializerDispatchNonByte {
     serializeEnum(s, *val);
   }
 
+  void applyIntrusive(SerializerT& s, T* val, std::false_type) {
+    val->template serialize<SerializerT>(s);
+    applyElm(s, val);
+  }
+
+  // The type reports its serialized size: size without traversing, and check
+  // the report against what packing actually produced in debug builds. The
+  // report describes the fixed encoding, so other wire modes traverse.
+  void applyIntrusive(SerializerT& s, T* val, std::true_type) {
+    if (s.getWireMode() != eWireMode::Fixed) {
+      applyIntrusive(s, val, std::false_type{});
+      return;
+    }
+
+    if (s.isSizing()) {
+      SerializerT::contiguousTyped(
+        s, static_cast<SerialByteType*>(nullptr), val->serializedSize()
+      );
+      return;
+    }
+
+    #if !defined(NDEBUG)
+      auto const begin = s.isPacking() ? s.getSpotIncrement(0) : nullptr;
+    #endif
+
+    val->template serialize<SerializerT>(s);
+    applyElm(s, val);
+
+    #if !defined(NDEBUG)
+      if (begin != nullptr) {
+        auto const packed = static_cast<SerialSizeType>(
+          s.getSpotIncrement(0) - begin
+        );
+        assert(
+          packed == val->serializedSize() &&
+          "serializedSize() must match the bytes serialize() packs"
+        );
+      }
+    #endif
+  }
+
   template <typename U = T>
   void apply(
     SerializerT& s, T* val, SerialSizeType num,
     hasInSerialize<U>* __attribute__((unused)) x = nullptr
   ) {
     debug_serdes("SerializerDispatch: intrusive serialize: val=%p\n", &val);
+    #if HAS_DETECTION_COMPONENT
+      using HasSizeHook = std::integral_constant<
+        bool, SerializableTraits<U>::has_serialized_size
+      >;
+    #else
+      using HasSizeHook = std::false_type;
+    #endif
     for (SerialSizeType i = 0; i < num; i++) {
-      val[i].template serialize<SerializerT>(s);
-      applyElm(s, val+i);
+      applyIntrusive(s, val+i, HasSizeHook{});
     }
   }
 
@@ -239,6 +291,19 @@ struct SerializerDispatchNonByte {
     }
   }
 
+  #if HAS_DETECTION_COMPONENT
+  template <typename U = T>
+  void apply(
+    SerializerT& s, T* val, SerialSizeType num,
+    hasFieldsSerialize<U>* __attribute__((unused)) x = nullptr
+  ) {
+    debug_serdes("SerializerDispatch: member list serialize: val=%p\n", &val);
+    for (SerialSizeType i = 0; i < num; i++) {
+      serializeFields(s, val[i]);
+    }
+  }
+  #endif
+
   template <typename U = T>
   void apply(
     SerializerT& s, T* val, SerialSizeType num,
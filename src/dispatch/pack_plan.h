@@ -0,0 +1,137 @@
+/*
+//@HEADER
+// *****************************************************************************
+//
+//                                 pack_plan.h
+//                           DARMA Toolkit v. 1.0.0
+//                 DARMA/checkpoint => Serialization Library
+//
+// Copyright 2019 National Technology & Engineering Solutions of Sandia, LLC
+// (NTESS). Under the terms of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the following disclaimer.
+//
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// * Neither the name of the copyright holder nor the names of its
+//   contributors may be used to endorse or promote products derived from this
+//   software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact darma@sandia.gov
+//
+// *****************************************************************************
+//@HEADER
+*/
+
+#if !defined INCLUDED_SERDES_PACK_PLAN
+#define INCLUDED_SERDES_PACK_PLAN
+
+#include "serdes_common.h"
+#include "serializers/serializers_headers.h"
+#include "dispatch/dispatch.h"
+#include "buffer/managed_buffer.h"
+#include "buffer/user_buffer.h"
+
+#include <memory>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+namespace serdes {
+
+/*
+ * Record the plan for packing `target` with one traversal. Bytes inside
+ * `target` and inside storage it owns (container buffers and elements) are
+ * recorded by address; everything else, including temporaries built during
+ * the traversal, is copied into the plan.
+ */
+template <typename T>
+void recordPackPlan(T& target, PackPlan& plan) {
+  using DispatchT = DispatchCommon<T>;
+  using CleanT = typename DispatchT::CleanT;
+
+  plan.clear();
+  PlanRecorder recorder(plan, &target, sizeof(T));
+  SerializerDispatch<PlanRecorder, CleanT> ap;
+  ap(recorder, DispatchT::clean(&target), 1);
+}
+
+/*
+ * Packs one object repeatedly through a recorded plan. `key_fn(target)`
+ * returns an equality-comparable shape key that must change whenever the
+ * object's shape does: container sizes and any reallocation (e.g., include
+ * data() pointers) and whenever a value the traversal copies into a
+ * temporary does. While the key matches, packing is a memcpy loop over the
+ * plan; otherwise the plan is re-recorded with one traversal first.
+ */
+template <typename T, typename ShapeKeyFnT>
+struct PlannedPacker {
+  using ShapeKeyType = typename std::decay<
+    decltype(std::declval<ShapeKeyFnT&>()(std::declval<T&>()))
+  >::type;
+
+  PlannedPacker(T& in_target, ShapeKeyFnT in_key_fn)
+    : target_(in_target), key_fn_(std::move(in_key_fn))
+  { }
+
+  SerializedReturnType pack(BufferObtainFnType fn = nullptr) {
+    auto key = key_fn_(target_);
+    replayed_ = has_plan_ and key == key_;
+    if (not replayed_) {
+      recordPackPlan(target_, plan_);
+      key_ = std::move(key);
+      has_plan_ = true;
+    }
+
+    auto const size = plan_.getSize();
+    SerialByteType* user_buf = fn ? fn(size) : nullptr;
+    BufferPtrType buf = user_buf ?
+      BufferPtrType(std::make_unique<UserBuffer>(user_buf, size)) :
+      BufferPtrType(std::make_unique<ManagedBuffer>(size));
+
+    plan_.replay(buf->getBuffer());
+    return std::make_tuple(std::move(buf), size);
+  }
+
+  // Drop the plan, e.g., after mutating the object in a way the key misses
+  void invalidate() { has_plan_ = false; }
+
+  bool lastReplayed() const { return replayed_; }
+  PackPlan const& getPlan() const { return plan_; }
+
+private:
+  T& target_;
+  ShapeKeyFnT key_fn_;
+  ShapeKeyType key_ = {};
+  bool has_plan_ = false;
+  bool replayed_ = false;
+  PackPlan plan_;
+};
+
+template <typename T, typename ShapeKeyFnT>
+PlannedPacker<T, ShapeKeyFnT> makePlannedPacker(T& target, ShapeKeyFnT key_fn) {
+  return PlannedPacker<T, ShapeKeyFnT>(target, std::move(key_fn));
+}
+
+} /* end namespace serdes */
+
+#endif /*INCLUDED_SERDES_PACK_PLAN*/
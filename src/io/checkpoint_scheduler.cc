@@ -0,0 +1,140 @@
+/*
+//@HEADER
+// *****************************************************************************
+//
+//                           checkpoint_scheduler.cc
+//                           DARMA Toolkit v. 1.0.0
+//                 DARMA/checkpoint => Serialization Library
+//
+// Copyright 2019 National Technology & Engineering Solutions of Sandia, LLC
+// (NTESS). Under the terms of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the following disclaimer.
+//
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// * Neither the name of the copyright holder nor the names of its
+//   contributors may be used to endorse or promote products derived from this
+//   software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact darma@sandia.gov
+//
+// *****************************************************************************
+//@HEADER
+*/
+
+#include "serdes_common.h"
+#include "io/checkpoint_scheduler.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+
+namespace serdes {
+
+CheckpointScheduler::CheckpointScheduler(
+  double const mtbf_seconds, double const smoothing
+) : mtbf_(mtbf_seconds), smoothing_(smoothing),
+    last_checkpoint_(ClockType::now())
+{
+  assert(mtbf_ > 0.0 && "MTBF must be positive");
+  assert(smoothing_ > 0.0 && smoothing_ <= 1.0 && "Smoothing must be in (0,1]");
+}
+
+/*static*/ double CheckpointScheduler::secondsSince(
+  ClockType::time_point const start
+) {
+  std::chrono::duration<double> const elapsed = ClockType::now() - start;
+  return elapsed.count();
+}
+
+/*static*/ double CheckpointScheduler::youngInterval(
+  double const cost, double const mtbf
+) {
+  return std::sqrt(2.0 * cost * mtbf);
+}
+
+/*static*/ double CheckpointScheduler::dalyInterval(
+  double const cost, double const mtbf
+) {
+  if (cost >= 2.0 * mtbf) {
+    return mtbf;
+  }
+  auto const ratio = cost / (2.0 * mtbf);
+  auto const interval =
+    youngInterval(cost, mtbf) * (1.0 + std::sqrt(ratio) / 3.0 + ratio / 9.0)
+    - cost;
+  return std::max(interval, 0.0);
+}
+
+bool CheckpointScheduler::shouldCheckpointNow() const {
+  if (not calibrated_) {
+    return true;
+  }
+  return secondsSince(last_checkpoint_) >= interval_;
+}
+
+void CheckpointScheduler::recordCost(CheckpointCost const& cost) {
+  // Sizing traverses the same state that is packed, so it scales with the
+  // number of bytes just like packing and writing
+  auto const per_byte = cost.bytes > 0 ? cost.total() / cost.bytes : 0.0;
+
+  if (not calibrated_) {
+    per_byte_cost_ = per_byte;
+    calibrated_ = true;
+  } else {
+    per_byte_cost_ = smoothing_ * per_byte + (1.0 - smoothing_) * per_byte_cost_;
+  }
+
+  state_size_ = cost.bytes;
+  last_cost_ = cost;
+  last_checkpoint_ = ClockType::now();
+  recompute();
+
+  debug_serdes(
+    "CheckpointScheduler: cost=%f, bytes=%zu, interval=%f\n",
+    cost.total(), cost.bytes, interval_
+  );
+}
+
+void CheckpointScheduler::setStateSize(SerialSizeType const bytes) {
+  state_size_ = bytes;
+  recompute();
+}
+
+void CheckpointScheduler::setMTBF(double const mtbf_seconds) {
+  assert(mtbf_seconds > 0.0 && "MTBF must be positive");
+  mtbf_ = mtbf_seconds;
+  recompute();
+}
+
+double CheckpointScheduler::getPredictedCost() const {
+  return per_byte_cost_ * state_size_;
+}
+
+void CheckpointScheduler::recompute() {
+  if (calibrated_) {
+    interval_ = dalyInterval(getPredictedCost(), mtbf_);
+  }
+}
+
+} /* end namespace serdes */
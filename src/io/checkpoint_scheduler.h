@@ -0,0 +1,191 @@
+/*
+//@HEADER
+// *****************************************************************************
+//
+//                            checkpoint_scheduler.h
+//                           DARMA Toolkit v. 1.0.0
+//                 DARMA/checkpoint => Serialization Library
+//
+// Copyright 2019 National Technology & Engineering Solutions of Sandia, LLC
+// (NTESS). Under the terms of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the following disclaimer.
+//
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// * Neither the name of the copyright holder nor the names of its
+//   contributors may be used to endorse or promote products derived from this
+//   software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact darma@sandia.gov
+//
+// *****************************************************************************
+//@HEADER
+*/
+
+#if !defined INCLUDED_SERDES_IO_CHECKPOINT_SCHEDULER
+#define INCLUDED_SERDES_IO_CHECKPOINT_SCHEDULER
+
+#include "serdes_common.h"
+#include "buffer/buffer.h"
+#include "buffer/aligned_buffer.h"
+#include "dispatch/dispatch.h"
+#include "io/direct_file.h"
+
+#include <chrono>
+#include <functional>
+#include <string>
+
+namespace serdes {
+
+/*
+ * Measured wall-clock cost (in seconds) of one checkpoint, split by phase
+ */
+struct CheckpointCost {
+  double sizing = 0.0;
+  double packing = 0.0;
+  double writing = 0.0;
+  SerialSizeType bytes = 0;
+
+  double total() const { return sizing + packing + writing; }
+};
+
+/*
+ * Decides when the application should checkpoint. Each checkpoint taken through
+ * the scheduler is timed per phase (sizing, packing, writing); every phase
+ * scales with the state, so the cost model is a smoothed per-byte cost and the
+ * predicted checkpoint cost tracks the current state size. The interval is recomputed
+ * from the predicted cost and the configured MTBF using Daly's higher-order
+ * estimate of the optimal checkpoint interval (which reduces to Young's
+ * sqrt(2*C*M) for small C).
+ *
+ * Until a first cost is measured shouldCheckpointNow() returns true so the
+ * application checkpoints once to calibrate.
+ */
+struct CheckpointScheduler {
+  using ClockType = std::chrono::steady_clock;
+  using WriteFnType = std::function<bool(Buffer& packed)>;
+
+  explicit CheckpointScheduler(double const mtbf_seconds, double const smoothing = 0.5);
+
+  // Intended to be called once per iteration of the application's time loop
+  bool shouldCheckpointNow() const;
+
+  /*
+   * Checkpoint `target` by sizing and packing it into a managed buffer and
+   * handing that to `write`. All three phases are timed and fed back into the
+   * interval. Returns the result of `write`.
+   */
+  template <typename T>
+  bool checkpoint(T& target, WriteFnType write);
+
+  // Like checkpoint() but writes an O_DIRECT file image (see serializeToFile)
+  template <typename T>
+  bool checkpointToFile(
+    T& target, std::string const& path, AlignedBufferPool* pool = nullptr,
+    SerialSizeType const& block = default_block_size
+  );
+
+  // Feed a cost measured elsewhere (also marks a checkpoint as just taken)
+  void recordCost(CheckpointCost const& cost);
+
+  // Update the expected state size so the interval tracks growth/shrinkage
+  void setStateSize(SerialSizeType const bytes);
+
+  void setMTBF(double const mtbf_seconds);
+
+  double getMTBF() const { return mtbf_; }
+  double getInterval() const { return interval_; }
+  double getPredictedCost() const;
+  CheckpointCost const& getLastCost() const { return last_cost_; }
+
+  static double youngInterval(double const cost, double const mtbf);
+  static double dalyInterval(double const cost, double const mtbf);
+
+private:
+  static double secondsSince(ClockType::time_point const start);
+  void recompute();
+
+private:
+  double mtbf_ = 0.0;
+  double smoothing_ = 0.5;
+  bool calibrated_ = false;
+  double per_byte_cost_ = 0.0;
+  SerialSizeType state_size_ = 0;
+  double interval_ = 0.0;
+  CheckpointCost last_cost_ = {};
+  ClockType::time_point last_checkpoint_;
+};
+
+template <typename T>
+bool CheckpointScheduler::checkpoint(T& target, WriteFnType write) {
+  CheckpointCost cost;
+
+  auto start = ClockType::now();
+  auto const size = Dispatch<T>::sizeType(target);
+  cost.sizing = secondsSince(start);
+
+  start = ClockType::now();
+  auto buf = Dispatch<T>::packType(target, size, nullptr);
+  cost.packing = secondsSince(start);
+
+  start = ClockType::now();
+  auto const success = write(*buf);
+  cost.writing = secondsSince(start);
+
+  cost.bytes = size;
+  recordCost(cost);
+  return success;
+}
+
+template <typename T>
+bool CheckpointScheduler::checkpointToFile(
+  T& target, std::string const& path, AlignedBufferPool* pool,
+  SerialSizeType const& block
+) {
+  CheckpointCost cost;
+
+  auto start = ClockType::now();
+  auto const size = Dispatch<T>::sizeType(target);
+  cost.sizing = secondsSince(start);
+
+  start = ClockType::now();
+  auto image = acquireFileImage(size, pool, block);
+  Dispatch<T>::packType(target, size, image->getBuffer());
+  cost.packing = secondsSince(start);
+
+  start = ClockType::now();
+  auto const success = writeFileImage(path, *image);
+  cost.writing = secondsSince(start);
+
+  if (pool != nullptr) {
+    pool->release(std::move(image));
+  }
+
+  cost.bytes = size;
+  recordCost(cost);
+  return success;
+}
+
+} /* end namespace serdes */
+
+#endif /*INCLUDED_SERDES_IO_CHECKPOINT_SCHEDULER*/
@@ -0,0 +1,263 @@
+/*
+//@HEADER
+// *****************************************************************************
+//
+//                                direct_file.cc
+//                           DARMA Toolkit v. 1.0.0
+//                 DARMA/checkpoint => Serialization Library
+//
+// Copyright 2019 National Technology & Engineering Solutions of Sandia, LLC
+// (NTESS). Under the terms of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the following disclaimer.
+//
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// * Neither the name of the copyright holder nor the names of its
+//   contributors may be used to endorse or promote products derived from this
+//   software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact darma@sandia.gov
+//
+// *****************************************************************************
+//@HEADER
+*/
+
+#include "serdes_common.h"
+#include "io/direct_file.h"
+#include "io/file_header.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cerrno>
+#include <cstring>
+
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace serdes {
+
+static int openFile(std::string const& path, eFileMode mode, bool direct) {
+  int flags = mode == eFileMode::Write ? O_WRONLY | O_CREAT | O_TRUNC : O_RDONLY;
+  #if defined(O_DIRECT)
+    if (direct) {
+      flags |= O_DIRECT;
+    }
+  #endif
+  return ::open(path.c_str(), flags, 0644);
+}
+
+DirectFile::DirectFile(std::string const& path, eFileMode const mode)
+  : mode_(mode)
+{
+  #if defined(O_DIRECT)
+    fd_ = openFile(path, mode, true);
+    direct_ = fd_ >= 0;
+    if (fd_ < 0 and errno == EINVAL) {
+      fd_ = openFile(path, mode, false);
+    }
+  #else
+    fd_ = openFile(path, mode, false);
+  #endif
+
+  #if defined(F_NOCACHE)
+    // macOS has no O_DIRECT, but F_NOCACHE gives the same cache bypass
+    if (fd_ >= 0 and fcntl(fd_, F_NOCACHE, 1) == 0) {
+      direct_ = true;
+    }
+  #endif
+
+  debug_serdes(
+    "DirectFile: path=%s, fd=%d, direct=%d\n", path.c_str(), fd_, direct_
+  );
+}
+
+DirectFile::~DirectFile() {
+  if (fd_ >= 0) {
+    ::close(fd_);
+  }
+}
+
+bool DirectFile::writeBlocks(
+  SerialByteType const* buf, SerialSizeType len, SerialSizeType offset
+) {
+  assert(mode_ == eFileMode::Write && "File must be opened for writing");
+  while (len > 0) {
+    auto const chunk = std::min(len, direct_io_chunk);
+    auto const ret = ::pwrite(fd_, buf, chunk, static_cast<off_t>(offset));
+    if (ret < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      return false;
+    }
+    buf += ret;
+    len -= ret;
+    offset += ret;
+    written_ = std::max(written_, offset);
+  }
+  return true;
+}
+
+bool DirectFile::readBlocks(
+  SerialByteType* buf, SerialSizeType len, SerialSizeType offset
+) {
+  assert(mode_ == eFileMode::Read && "File must be opened for reading");
+  while (len > 0) {
+    auto const chunk = std::min(len, direct_io_chunk);
+    auto const ret = ::pread(fd_, buf, chunk, static_cast<off_t>(offset));
+    if (ret < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      return false;
+    }
+    if (ret == 0) {
+      // Unexpected end of file: the header promised more data
+      return false;
+    }
+    buf += ret;
+    len -= ret;
+    offset += ret;
+  }
+  return true;
+}
+
+bool DirectFile::sync() {
+  if (::fsync(fd_) != 0) {
+    return false;
+  }
+  #if defined(POSIX_FADV_DONTNEED)
+    if (not direct_) {
+      // Buffered fallback: drop the now-clean pages so a large checkpoint does
+      // not evict the application's own file-backed memory
+      ::posix_fadvise(fd_, 0, static_cast<off_t>(written_), POSIX_FADV_DONTNEED);
+    }
+  #endif
+  return true;
+}
+
+SerialSizeType DirectFile::fileSize() const {
+  struct stat st;
+  if (::fstat(fd_, &st) != 0) {
+    return 0;
+  }
+  return static_cast<SerialSizeType>(st.st_size);
+}
+
+std::unique_ptr<AlignedBuffer> acquireFileImage(
+  SerialSizeType const payload_size, AlignedBufferPool* pool,
+  SerialSizeType const block
+) {
+  auto const capacity = FileHeader(payload_size, block).imageSize();
+  std::unique_ptr<AlignedBuffer> image = nullptr;
+  if (pool != nullptr and pool->getAlignment() == block) {
+    image = pool->acquire(capacity);
+  } else {
+    image = std::make_unique<AlignedBuffer>(capacity, block);
+  }
+  image->setPayload(FileHeader::headerSize(block), payload_size);
+  return image;
+}
+
+bool writeFileImage(
+  std::string const& path, AlignedBuffer& image, WriteChunkFnType on_chunk,
+  SerialSizeType const chunk
+) {
+  auto const block = image.getAlignment();
+  FileHeader header(image.getSize(), block);
+  assert(
+    image.getOffset() == header.header_size &&
+    "Payload must be placed directly after the header block"
+  );
+  assert(header.imageSize() <= image.getCapacity() && "Image must fit");
+
+  DirectFile file(path, eFileMode::Write);
+  if (not file.isOpen()) {
+    return false;
+  }
+
+  if (file.isDirect()) {
+    header.flags |= FileHeader::eFlags::DirectIO;
+  }
+
+  header.writeTo(image.getBlock());
+  std::memset(image.getBuffer() + header.payload_size, 0, header.tail_padding);
+
+  auto const total = header.imageSize();
+  auto const step = roundUpToBlock(chunk, block);
+  for (SerialSizeType off = 0; off < total; off += step) {
+    auto const len = std::min(step, total - off);
+    if (on_chunk) {
+      on_chunk(len);
+    }
+    if (not file.writeBlocks(image.getBlock() + off, len, off)) {
+      return false;
+    }
+  }
+
+  return file.sync();
+}
+
+std::unique_ptr<AlignedBuffer> readFileImage(
+  std::string const& path, AlignedBufferPool* pool
+) {
+  DirectFile file(path, eFileMode::Read);
+  if (not file.isOpen()) {
+    return nullptr;
+  }
+
+  // The header fits in the writer's first block, which may be smaller than the
+  // default block; the file size is always a whole number of writer blocks
+  auto const first_len = std::min(default_block_size, file.fileSize());
+  if (first_len < sizeof(FileHeader)) {
+    return nullptr;
+  }
+  AlignedBuffer first(default_block_size, default_block_size);
+  if (not file.readBlocks(first.getBlock(), first_len, 0)) {
+    return nullptr;
+  }
+
+  auto const header = FileHeader::readFrom(first.getBlock());
+  if (not header.valid() or file.fileSize() < header.imageSize()) {
+    return nullptr;
+  }
+
+  auto image = acquireFileImage(header.payload_size, pool, header.block_size);
+  if (image->getOffset() != header.header_size or
+      image->getCapacity() < header.imageSize()) {
+    return nullptr;
+  }
+
+  // The header blocks already read are copied; the rest comes from the file
+  auto const head = std::min<SerialSizeType>(header.header_size, first_len);
+  std::memcpy(image->getBlock(), first.getBlock(), head);
+  if (not file.readBlocks(
+        image->getBlock() + head, header.imageSize() - head, head
+      )) {
+    return nullptr;
+  }
+  return image;
+}
+
+} /* end namespace serdes */
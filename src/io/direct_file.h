@@ -0,0 +1,137 @@
+/*
+//@HEADER
+// *****************************************************************************
+//
+//                                direct_file.h
+//                           DARMA Toolkit v. 1.0.0
+//                 DARMA/checkpoint => Serialization Library
+//
+// Copyright 2019 National Technology & Engineering Solutions of Sandia, LLC
+// (NTESS). Under the terms of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the following disclaimer.
+//
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// * Neither the name of the copyright holder nor the names of its
+//   contributors may be used to endorse or promote products derived from this
+//   software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact darma@sandia.gov
+//
+// *****************************************************************************
+//@HEADER
+*/
+
+#if !defined INCLUDED_SERDES_IO_DIRECT_FILE
+#define INCLUDED_SERDES_IO_DIRECT_FILE
+
+#include "serdes_common.h"
+#include "buffer/aligned_buffer.h"
+#include "io/file_header.h"
+
+#include <functional>
+#include <memory>
+#include <string>
+
+namespace serdes {
+
+// Largest single write()/read() issued against the file; keeps each request a
+// whole number of blocks while bounding the time any one syscall can take
+static constexpr SerialSizeType const direct_io_chunk = 8 * 1024 * 1024;
+
+enum struct eFileMode : int8_t {
+  Read = 0,
+  Write = 1
+};
+
+/*
+ * Thin RAII wrapper over a POSIX file descriptor opened with O_DIRECT so that
+ * checkpoint data bypasses the page cache. When the underlying file system
+ * refuses O_DIRECT (e.g., tmpfs) the file is opened buffered instead and the
+ * written range is dropped from the page cache after it is synced.
+ *
+ * All offsets, lengths, and buffer addresses passed to readBlocks/writeBlocks
+ * must be multiples of the block size.
+ */
+struct DirectFile {
+  DirectFile(std::string const& path, eFileMode const mode);
+  DirectFile(DirectFile const&) = delete;
+  DirectFile& operator=(DirectFile const&) = delete;
+  ~DirectFile();
+
+  bool isOpen() const { return fd_ >= 0; }
+  bool isDirect() const { return direct_; }
+
+  bool writeBlocks(
+    SerialByteType const* buf, SerialSizeType len, SerialSizeType offset
+  );
+  bool readBlocks(SerialByteType* buf, SerialSizeType len, SerialSizeType offset);
+  bool sync();
+  SerialSizeType fileSize() const;
+
+private:
+  int fd_ = -1;
+  bool direct_ = false;
+  eFileMode mode_ = eFileMode::Read;
+  SerialSizeType written_ = 0;
+};
+
+// Invoked with the length of each chunk right before it is written; used to
+// pace the writer (e.g., against a token bucket)
+using WriteChunkFnType = std::function<void(SerialSizeType len)>;
+
+/*
+ * Allocate a block-aligned image (from `pool` when its alignment matches
+ * `block`) large enough for the header, `payload_size` bytes, and tail padding,
+ * with the payload placed directly after the header.
+ */
+std::unique_ptr<AlignedBuffer> acquireFileImage(
+  SerialSizeType const payload_size, AlignedBufferPool* pool,
+  SerialSizeType const block
+);
+
+/*
+ * Write a complete file image (header block, payload, zeroed tail padding) that
+ * lives in `image` with the payload at image.getBuffer(). If `on_chunk` is
+ * supplied the image is written in pieces of `chunk` bytes, calling `on_chunk`
+ * before each one. Returns false on any I/O failure.
+ */
+bool writeFileImage(
+  std::string const& path, AlignedBuffer& image,
+  WriteChunkFnType on_chunk = nullptr,
+  SerialSizeType const chunk = direct_io_chunk
+);
+
+/*
+ * Read a file produced by writeFileImage. The returned buffer's getBuffer() and
+ * getSize() describe only the payload (header and tail padding are stripped) so
+ * it can be handed directly to the Unpacker. Returns nullptr if the file can
+ * not be read or the header is not valid.
+ */
+std::unique_ptr<AlignedBuffer> readFileImage(
+  std::string const& path, AlignedBufferPool* pool = nullptr
+);
+
+} /* end namespace serdes */
+
+#endif /*INCLUDED_SERDES_IO_DIRECT_FILE*/
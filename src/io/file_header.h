@@ -0,0 +1,123 @@
+/*
+//@HEADER
+// *****************************************************************************
+//
+//                                file_header.h
+//                           DARMA Toolkit v. 1.0.0
+//                 DARMA/checkpoint => Serialization Library
+//
+// Copyright 2019 National Technology & Engineering Solutions of Sandia, LLC
+// (NTESS). Under the terms of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the following disclaimer.
+//
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// * Neither the name of the copyright holder nor the names of its
+//   contributors may be used to endorse or promote products derived from this
+//   software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact darma@sandia.gov
+//
+// *****************************************************************************
+//@HEADER
+*/
+
+#if !defined INCLUDED_SERDES_IO_FILE_HEADER
+#define INCLUDED_SERDES_IO_FILE_HEADER
+
+#include "serdes_common.h"
+#include "buffer/aligned_buffer.h"
+
+#include <cstdint>
+#include <cstring>
+#include <limits>
+
+namespace serdes {
+
+/*
+ * On-disk header that precedes the serialized payload in a checkpoint file. It
+ * occupies the first block of the file so the payload itself starts at an
+ * aligned offset. The payload is followed by `tail_padding` zero bytes so the
+ * whole file is a multiple of the block size; restore strips the padding using
+ * `payload_size`.
+ */
+struct FileHeader {
+  static constexpr uint64_t const file_magic = 0x4b43504553454453ULL;
+  static constexpr uint32_t const file_version = 1;
+
+  enum eFlags : uint32_t {
+    None = 0,
+    DirectIO = 1
+  };
+
+  uint64_t magic = file_magic;
+  uint32_t version = file_version;
+  uint32_t flags = eFlags::None;
+  uint64_t block_size = default_block_size;
+  uint64_t header_size = default_block_size;
+  uint64_t payload_size = 0;
+  uint64_t tail_padding = 0;
+
+  FileHeader() = default;
+
+  FileHeader(SerialSizeType const& in_payload, SerialSizeType const& in_block)
+    : block_size(in_block),
+      header_size(roundUpToBlock(sizeof(FileHeader), in_block)),
+      payload_size(in_payload),
+      tail_padding(roundUpToBlock(in_payload, in_block) - in_payload)
+  { }
+
+  // Fields come from disk, so check everything later used as a size/offset
+  bool valid() const {
+    auto const max = std::numeric_limits<uint64_t>::max();
+    return magic == file_magic and version == file_version and
+      block_size >= sizeof(void*) and (block_size & (block_size - 1)) == 0 and
+      header_size == headerSize(block_size) and tail_padding < block_size and
+      payload_size <= max - header_size - tail_padding and
+      (payload_size + tail_padding) % block_size == 0;
+  }
+
+  // Total bytes on disk: header block(s), payload, and tail padding
+  SerialSizeType imageSize() const {
+    return header_size + payload_size + tail_padding;
+  }
+
+  static SerialSizeType headerSize(SerialSizeType const& block) {
+    return roundUpToBlock(sizeof(FileHeader), block);
+  }
+
+  void writeTo(SerialByteType* block) const {
+    std::memset(block, 0, header_size);
+    std::memcpy(block, this, sizeof(FileHeader));
+  }
+
+  static FileHeader readFrom(SerialByteType const* block) {
+    FileHeader header;
+    std::memcpy(&header, block, sizeof(FileHeader));
+    return header;
+  }
+};
+
+} /* end namespace serdes */
+
+#endif /*INCLUDED_SERDES_IO_FILE_HEADER*/
@@ -0,0 +1,188 @@
+/*
+//@HEADER
+// *****************************************************************************
+//
+//                               file_serialize.h
+//                           DARMA Toolkit v. 1.0.0
+//                 DARMA/checkpoint => Serialization Library
+//
+// Copyright 2019 National Technology & Engineering Solutions of Sandia, LLC
+// (NTESS). Under the terms of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the following disclaimer.
+//
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// * Neither the name of the copyright holder nor the names of its
+//   contributors may be used to endorse or promote products derived from this
+//   software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact darma@sandia.gov
+//
+// *****************************************************************************
+//@HEADER
+*/
+
+#if !defined INCLUDED_SERDES_IO_FILE_SERIALIZE
+#define INCLUDED_SERDES_IO_FILE_SERIALIZE
+
+#include "serdes_common.h"
+#include "buffer/aligned_buffer.h"
+#include "dispatch/dispatch.h"
+#include "io/file_header.h"
+#include "io/direct_file.h"
+#include "io/striped_file.h"
+#include "io/throttled_writer.h"
+
+#include <string>
+#include <vector>
+
+namespace serdes {
+
+/*
+ * Serialize `target` straight into a block-aligned image (obtained from `pool`
+ * if one is supplied) with room for the file header in front of it. The result
+ * is ready to be handed to writeFileImage.
+ */
+template <typename T>
+std::unique_ptr<AlignedBuffer> packFileImage(
+  T& target, AlignedBufferPool* pool = nullptr,
+  SerialSizeType const& block = default_block_size
+) {
+  std::unique_ptr<AlignedBuffer> image = nullptr;
+
+  auto ret = serializeType<T>(target, [&](SerialSizeType size) {
+    image = acquireFileImage(size, pool, block);
+    return image->getBuffer();
+  });
+
+  image->setPayload(FileHeader::headerSize(block), std::get<1>(ret));
+  return image;
+}
+
+/*
+ * Serialize `target` into an aligned image and write it to `path` with
+ * O_DIRECT. The page cache is bypassed so large checkpoints do not evict
+ * application data or leave a writeback backlog.
+ */
+template <typename T>
+bool serializeToFile(
+  T& target, std::string const& path, AlignedBufferPool* pool = nullptr,
+  SerialSizeType const& block = default_block_size
+) {
+  auto image = packFileImage(target, pool, block);
+  auto const success = writeFileImage(path, *image);
+
+  if (pool != nullptr) {
+    pool->release(std::move(image));
+  }
+  return success;
+}
+
+/*
+ * Pack `target` now (so the checkpoint is a consistent snapshot) and let the
+ * rate-limited background `writer` flush it to `path`. The resulting file is
+ * identical to one written by serializeToFile.
+ */
+template <typename T>
+void serializeToFileThrottled(
+  T& target, std::string const& path, ThrottledWriter& writer,
+  ThrottledWriter::DoneFnType done = nullptr, AlignedBufferPool* pool = nullptr,
+  SerialSizeType const& block = default_block_size
+) {
+  writer.enqueue(path, packFileImage(target, pool, block), done, pool);
+}
+
+/*
+ * Restore an object from a file written by serializeToFile. Returns nullptr if
+ * the file could not be read or does not carry a valid header.
+ */
+template <typename T>
+T* deserializeFromFile(
+  std::string const& path, T* allocBuf = nullptr,
+  AlignedBufferPool* pool = nullptr
+) {
+  auto image = readFileImage(path, pool);
+  if (image == nullptr) {
+    return nullptr;
+  }
+
+  auto t = deserializeType<T>(image->getBuffer(), image->getSize(), allocBuf);
+
+  if (pool != nullptr) {
+    pool->release(std::move(image));
+  }
+  return t;
+}
+
+/*
+ * Serialize `target` and spread the packed bytes round-robin over one stripe
+ * file per directory in `dirs`, written concurrently. The manifest describing
+ * the layout is placed in dirs[0] and is returned through `manifest_path`.
+ */
+template <typename T>
+bool serializeToStripes(
+  T& target, std::vector<std::string> const& dirs, std::string const& name,
+  std::string* manifest_path = nullptr,
+  SerialSizeType const& stripe_unit = default_stripe_unit,
+  SerialSizeType const& block = default_block_size
+) {
+  std::unique_ptr<AlignedBuffer> image = nullptr;
+
+  auto ret = serializeType<T>(target, [&](SerialSizeType size) {
+    image = std::make_unique<AlignedBuffer>(roundUpToBlock(size, block), block);
+    return image->getBuffer();
+  });
+
+  StripeManifest manifest;
+  manifest.payload_size = std::get<1>(ret);
+  manifest.block_size = block;
+  manifest.stripe_unit = roundUpToBlock(stripe_unit, block);
+  for (std::size_t j = 0; j < dirs.size(); j++) {
+    manifest.stripes.push_back(StripeManifest::stripePath(dirs, name, j));
+  }
+
+  auto const path = StripeManifest::manifestPath(dirs, name);
+  if (manifest_path != nullptr) {
+    *manifest_path = path;
+  }
+  return writeStripes(manifest, path, *image);
+}
+
+/*
+ * Restore an object from the stripes described by the manifest at
+ * `manifest_path`; every stripe is read concurrently before unpacking.
+ */
+template <typename T>
+T* deserializeFromStripes(
+  std::string const& manifest_path, T* allocBuf = nullptr
+) {
+  auto image = readStripes(manifest_path);
+  if (image == nullptr) {
+    return nullptr;
+  }
+  return deserializeType<T>(image->getBuffer(), image->getSize(), allocBuf);
+}
+
+} /* end namespace serdes */
+
+#endif /*INCLUDED_SERDES_IO_FILE_SERIALIZE*/
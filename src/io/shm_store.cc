@@ -0,0 +1,261 @@
+/*
+//@HEADER
+// *****************************************************************************
+//
+//                                 shm_store.cc
+//                           DARMA Toolkit v. 1.0.0
+//                 DARMA/checkpoint => Serialization Library
+//
+// Copyright 2019 National Technology & Engineering Solutions of Sandia, LLC
+// (NTESS). Under the terms of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the following disclaimer.
+//
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// * Neither the name of the copyright holder nor the names of its
+//   contributors may be used to endorse or promote products derived from this
+//   software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact darma@sandia.gov
+//
+// *****************************************************************************
+//@HEADER
+*/
+
+#include "serdes_common.h"
+#include "io/shm_store.h"
+
+#include <cassert>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace serdes {
+
+static constexpr uint64_t const shm_magic = 0x4d48534553454453;
+static constexpr uint32_t const shm_format = 1;
+static constexpr SerialSizeType const shm_slot_align = 64;
+
+static_assert(
+  ATOMIC_LLONG_LOCK_FREE == 2,
+  "Shared-memory commit markers require lock-free 64-bit atomics"
+);
+
+/*static*/ constexpr SharedMemoryStore::VersionType const
+  SharedMemoryStore::no_version;
+
+/*static*/ SerialSizeType SharedMemoryStore::slotStride(
+  SerialSizeType const slot_capacity
+) {
+  auto const bytes = sizeof(SlotHeader) + slot_capacity;
+  return (bytes + shm_slot_align - 1) / shm_slot_align * shm_slot_align;
+}
+
+/*static*/ SerialSizeType SharedMemoryStore::segmentSize(
+  std::size_t const num_slots, SerialSizeType const slot_capacity
+) {
+  auto const header = (sizeof(SegmentHeader) + shm_slot_align - 1) /
+    shm_slot_align * shm_slot_align;
+  return header + num_slots * slotStride(slot_capacity);
+}
+
+SharedMemoryStore::SharedMemoryStore(
+  std::string const& name, std::size_t const num_versions,
+  SerialSizeType const slot_capacity
+) {
+  assert(num_versions > 0 && "Must retain at least one version");
+
+  int const fd = ::shm_open(name.c_str(), O_RDWR | O_CREAT, 0600);
+  if (fd < 0) {
+    return;
+  }
+
+  auto const bytes = segmentSize(num_versions, slot_capacity);
+
+  struct stat st;
+  bool const exists = ::fstat(fd, &st) == 0 and
+    static_cast<SerialSizeType>(st.st_size) == bytes;
+
+  if (not exists and ::ftruncate(fd, bytes) != 0) {
+    ::close(fd);
+    return;
+  }
+
+  if (not attach(fd, bytes)) {
+    return;
+  }
+
+  bool const compatible = exists and
+    header_->magic == shm_magic and
+    header_->format == shm_format and
+    header_->num_slots == num_versions and
+    header_->slot_capacity == slot_capacity;
+
+  if (not compatible) {
+    header_->magic = shm_magic;
+    header_->format = shm_format;
+    header_->num_slots = static_cast<uint32_t>(num_versions);
+    header_->slot_capacity = slot_capacity;
+    header_->slot_stride = slotStride(slot_capacity);
+    for (std::size_t i = 0; i < num_versions; i++) {
+      slotHeader(i)->version.store(no_version, std::memory_order_relaxed);
+      slotHeader(i)->size = 0;
+    }
+    header_->committed.store(no_version, std::memory_order_release);
+  }
+}
+
+SharedMemoryStore::SharedMemoryStore(std::string const& name) {
+  int const fd = ::shm_open(name.c_str(), O_RDWR, 0600);
+  if (fd < 0) {
+    return;
+  }
+
+  struct stat st;
+  if (::fstat(fd, &st) != 0 or
+      static_cast<SerialSizeType>(st.st_size) < sizeof(SegmentHeader)) {
+    ::close(fd);
+    return;
+  }
+
+  auto const bytes = static_cast<SerialSizeType>(st.st_size);
+  if (not attach(fd, bytes)) {
+    return;
+  }
+
+  bool const valid = header_->magic == shm_magic and
+    header_->format == shm_format and
+    header_->num_slots > 0 and
+    segmentSize(header_->num_slots, header_->slot_capacity) == bytes;
+
+  if (not valid) {
+    ::munmap(header_, mapped_bytes_);
+    header_ = nullptr;
+    mapped_bytes_ = 0;
+  }
+}
+
+SharedMemoryStore::~SharedMemoryStore() {
+  if (header_ != nullptr) {
+    ::munmap(header_, mapped_bytes_);
+  }
+}
+
+bool SharedMemoryStore::attach(int const fd, SerialSizeType const bytes) {
+  void* addr = ::mmap(
+    nullptr, bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0
+  );
+  // The mapping holds its own reference to the segment
+  ::close(fd);
+
+  if (addr == MAP_FAILED) {
+    return false;
+  }
+  header_ = static_cast<SegmentHeader*>(addr);
+  mapped_bytes_ = bytes;
+  return true;
+}
+
+std::size_t SharedMemoryStore::getNumVersions() const {
+  return header_ ? header_->num_slots : 0;
+}
+
+SerialSizeType SharedMemoryStore::getSlotCapacity() const {
+  return header_ ? header_->slot_capacity : 0;
+}
+
+SharedMemoryStore::SlotHeader* SharedMemoryStore::slotHeader(
+  std::size_t const slot
+) const {
+  auto const base = reinterpret_cast<SerialByteType*>(header_) +
+    segmentSize(0, header_->slot_capacity);
+  return reinterpret_cast<SlotHeader*>(base + slot * header_->slot_stride);
+}
+
+SerialByteType* SharedMemoryStore::slotData(std::size_t const slot) const {
+  return reinterpret_cast<SerialByteType*>(slotHeader(slot)) +
+    sizeof(SlotHeader);
+}
+
+SharedMemoryStore::VersionType SharedMemoryStore::latestVersion() const {
+  if (header_ == nullptr) {
+    return no_version;
+  }
+  return header_->committed.load(std::memory_order_acquire);
+}
+
+bool SharedMemoryStore::hasVersion(VersionType const version) const {
+  if (header_ == nullptr or version == no_version) {
+    return false;
+  }
+  auto const slot = slotHeader(version % header_->num_slots);
+  return version <= latestVersion() and
+    slot->version.load(std::memory_order_acquire) == version;
+}
+
+SerialByteType* SharedMemoryStore::beginStore(
+  SerialSizeType const size, VersionType& version
+) {
+  if (header_ == nullptr or size > header_->slot_capacity) {
+    return nullptr;
+  }
+
+  version = latestVersion() + 1;
+  auto const slot = version % header_->num_slots;
+
+  // Retire the oldest version before overwriting its slot so a crash while
+  // packing can never expose a torn image
+  slotHeader(slot)->version.store(no_version, std::memory_order_release);
+  return slotData(slot);
+}
+
+void SharedMemoryStore::commitStore(
+  VersionType const version, SerialSizeType const size
+) {
+  auto const slot = slotHeader(version % header_->num_slots);
+  slot->size = size;
+  slot->version.store(version, std::memory_order_release);
+  header_->committed.store(version, std::memory_order_release);
+}
+
+SerialByteType* SharedMemoryStore::versionData(
+  VersionType& version, SerialSizeType& size
+) const {
+  if (version == no_version) {
+    version = latestVersion();
+  }
+  if (not hasVersion(version)) {
+    return nullptr;
+  }
+  auto const slot = version % header_->num_slots;
+  size = slotHeader(slot)->size;
+  return slotData(slot);
+}
+
+/*static*/ bool SharedMemoryStore::unlink(std::string const& name) {
+  return ::shm_unlink(name.c_str()) == 0;
+}
+
+} /* end namespace serdes */
@@ -0,0 +1,170 @@
+/*
+//@HEADER
+// *****************************************************************************
+//
+//                                 shm_store.h
+//                           DARMA Toolkit v. 1.0.0
+//                 DARMA/checkpoint => Serialization Library
+//
+// Copyright 2019 National Technology & Engineering Solutions of Sandia, LLC
+// (NTESS). Under the terms of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the following disclaimer.
+//
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// * Neither the name of the copyright holder nor the names of its
+//   contributors may be used to endorse or promote products derived from this
+//   software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact darma@sandia.gov
+//
+// *****************************************************************************
+//@HEADER
+*/
+
+#if !defined INCLUDED_SERDES_IO_SHM_STORE
+#define INCLUDED_SERDES_IO_SHM_STORE
+
+#include "serdes_common.h"
+#include "dispatch/dispatch.h"
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+
+namespace serdes {
+
+/*
+ * Checkpoint store backed by a named POSIX shared-memory segment. It survives a
+ * process crash (but not a node failure), so a restarted process on the same
+ * node can deserialize straight out of shared memory.
+ *
+ * The segment holds `num_versions` fixed-capacity slots used as a ring: version
+ * `v` lives in slot `v % num_versions`, so the last K versions are retained.
+ * A version is committed by publishing its number in the slot and then in the
+ * segment header with release stores; a writer that dies mid-pack leaves the
+ * previous version as the latest committed one.
+ */
+struct SharedMemoryStore {
+  using VersionType = uint64_t;
+
+  static constexpr VersionType const no_version = 0;
+
+  // Create the segment, or attach to an existing one with the same geometry
+  // (retaining its versions)
+  SharedMemoryStore(
+    std::string const& name, std::size_t const num_versions,
+    SerialSizeType const slot_capacity
+  );
+
+  // Attach to an existing segment, e.g., after a restart
+  explicit SharedMemoryStore(std::string const& name);
+
+  SharedMemoryStore(SharedMemoryStore const&) = delete;
+  SharedMemoryStore& operator=(SharedMemoryStore const&) = delete;
+  ~SharedMemoryStore();
+
+  bool isOpen() const { return header_ != nullptr; }
+
+  std::size_t getNumVersions() const;
+  SerialSizeType getSlotCapacity() const;
+
+  VersionType latestVersion() const;
+  bool hasVersion(VersionType const version) const;
+
+  /*
+   * Pack `target` directly into the next slot and commit it. Returns the new
+   * version, or no_version if the packed size exceeds the slot capacity.
+   */
+  template <typename T>
+  VersionType store(T& target);
+
+  /*
+   * Deserialize `version` (the latest by default) straight out of shared
+   * memory. Returns nullptr if that version is not (or no longer) available.
+   * Loading must not race with a store that recycles the same slot.
+   */
+  template <typename T>
+  T* load(T* allocBuf = nullptr, VersionType version = no_version);
+
+  // Remove the named segment from the system
+  static bool unlink(std::string const& name);
+
+private:
+  struct SlotHeader {
+    std::atomic<VersionType> version;
+    SerialSizeType size;
+  };
+
+  struct SegmentHeader {
+    uint64_t magic;
+    uint32_t format;
+    uint32_t num_slots;
+    SerialSizeType slot_capacity;
+    SerialSizeType slot_stride;
+    std::atomic<VersionType> committed;
+  };
+
+  bool attach(int const fd, SerialSizeType const bytes);
+  SlotHeader* slotHeader(std::size_t const slot) const;
+  SerialByteType* slotData(std::size_t const slot) const;
+  SerialByteType* beginStore(SerialSizeType const size, VersionType& version);
+  void commitStore(VersionType const version, SerialSizeType const size);
+  SerialByteType* versionData(VersionType& version, SerialSizeType& size) const;
+
+  static SerialSizeType slotStride(SerialSizeType const slot_capacity);
+  static SerialSizeType segmentSize(
+    std::size_t const num_slots, SerialSizeType const slot_capacity
+  );
+
+private:
+  SegmentHeader* header_ = nullptr;
+  SerialSizeType mapped_bytes_ = 0;
+};
+
+template <typename T>
+SharedMemoryStore::VersionType SharedMemoryStore::store(T& target) {
+  auto const size = Dispatch<T>::sizeType(target);
+  VersionType version = no_version;
+  auto const spot = beginStore(size, version);
+  if (spot == nullptr) {
+    return no_version;
+  }
+  Dispatch<T>::packType(target, size, spot);
+  commitStore(version, size);
+  return version;
+}
+
+template <typename T>
+T* SharedMemoryStore::load(T* allocBuf, VersionType version) {
+  SerialSizeType size = 0;
+  auto const data = versionData(version, size);
+  if (data == nullptr) {
+    return nullptr;
+  }
+  return deserializeType<T>(data, size, allocBuf);
+}
+
+} /* end namespace serdes */
+
+#endif /*INCLUDED_SERDES_IO_SHM_STORE*/
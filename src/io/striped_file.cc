@@ -0,0 +1,273 @@
+/*
+//@HEADER
+// *****************************************************************************
+//
+//                               striped_file.cc
+//                           DARMA Toolkit v. 1.0.0
+//                 DARMA/checkpoint => Serialization Library
+//
+// Copyright 2019 National Technology & Engineering Solutions of Sandia, LLC
+// (NTESS). Under the terms of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the following disclaimer.
+//
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// * Neither the name of the copyright holder nor the names of its
+//   contributors may be used to endorse or promote products derived from this
+//   software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact darma@sandia.gov
+//
+// *****************************************************************************
+//@HEADER
+*/
+
+#include "serdes_common.h"
+#include "io/striped_file.h"
+#include "io/direct_file.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <cerrno>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <thread>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+namespace serdes {
+
+static constexpr char const* const manifest_tag = "serdes-stripe-manifest";
+
+SerialSizeType StripeManifest::stripeSize(std::size_t const j) const {
+  auto const padded = paddedSize();
+  auto const num_stripes = stripes.size();
+  SerialSizeType total = 0;
+  for (SerialSizeType off = j * stripe_unit; off < padded;
+       off += num_stripes * stripe_unit) {
+    total += std::min(stripe_unit, padded - off);
+  }
+  return total;
+}
+
+static bool writeAll(int fd, std::string const& data) {
+  auto buf = data.data();
+  auto len = data.size();
+  while (len > 0) {
+    auto const ret = ::write(fd, buf, len);
+    if (ret < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      return false;
+    }
+    buf += ret;
+    len -= ret;
+  }
+  return true;
+}
+
+static bool syncParentDir(std::string const& path) {
+  auto const slash = path.find_last_of('/');
+  auto const dir = slash == std::string::npos ? "." : path.substr(0, slash + 1);
+  int const fd = ::open(dir.c_str(), O_RDONLY);
+  if (fd < 0) {
+    return false;
+  }
+  auto const synced = ::fsync(fd) == 0;
+  ::close(fd);
+  return synced;
+}
+
+bool StripeManifest::write(std::string const& path) const {
+  std::ostringstream out;
+  out << manifest_tag << " " << manifest_version << "\n"
+      << "payload_size " << payload_size << "\n"
+      << "block_size " << block_size << "\n"
+      << "stripe_unit " << stripe_unit << "\n"
+      << "stripes " << stripes.size() << "\n";
+  for (auto&& stripe : stripes) {
+    out << stripe << "\n";
+  }
+
+  // Write a durable temporary and rename it into place so a reader never sees
+  // a partially written manifest
+  auto const tmp_path = path + ".tmp";
+  int const fd = ::open(tmp_path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+  if (fd < 0) {
+    return false;
+  }
+  auto const wrote = writeAll(fd, out.str()) and ::fsync(fd) == 0;
+  ::close(fd);
+
+  if (not wrote or ::rename(tmp_path.c_str(), path.c_str()) != 0) {
+    ::unlink(tmp_path.c_str());
+    return false;
+  }
+  return syncParentDir(path);
+}
+
+bool StripeManifest::read(std::string const& path, StripeManifest& manifest) {
+  std::ifstream in(path);
+  std::string tag, key;
+  int version = 0;
+  std::size_t num_stripes = 0;
+
+  in >> tag >> version;
+  if (not in or tag != manifest_tag or version != manifest_version) {
+    return false;
+  }
+
+  in >> key >> manifest.payload_size;
+  in >> key >> manifest.block_size;
+  in >> key >> manifest.stripe_unit;
+  in >> key >> num_stripes;
+  in >> std::ws;
+
+  manifest.stripes.clear();
+  for (std::size_t j = 0; j < num_stripes; j++) {
+    std::string stripe;
+    std::getline(in, stripe);
+    manifest.stripes.push_back(stripe);
+  }
+
+  return
+    in and num_stripes > 0 and manifest.block_size > 0 and
+    manifest.stripe_unit > 0 and manifest.stripe_unit % manifest.block_size == 0;
+}
+
+std::string StripeManifest::manifestPath(
+  std::vector<std::string> const& dirs, std::string const& name
+) {
+  assert(dirs.size() > 0 && "Must have at least one stripe directory");
+  return dirs[0] + "/" + name + ".manifest";
+}
+
+std::string StripeManifest::stripePath(
+  std::vector<std::string> const& dirs, std::string const& name,
+  std::size_t const j
+) {
+  return dirs[j] + "/" + name + ".stripe" + std::to_string(j);
+}
+
+template <typename FnT>
+static bool forEachStripe(StripeManifest const& manifest, FnT&& fn) {
+  auto const num_stripes = manifest.stripes.size();
+  std::atomic<bool> success(true);
+  std::vector<std::thread> threads;
+
+  for (std::size_t j = 0; j < num_stripes; j++) {
+    threads.emplace_back([&success,&fn,j]{
+      if (not fn(j)) {
+        success = false;
+      }
+    });
+  }
+
+  for (auto&& t : threads) {
+    t.join();
+  }
+
+  return success;
+}
+
+bool writeStripes(
+  StripeManifest const& manifest, std::string const& manifest_path,
+  AlignedBuffer& image
+) {
+  auto const num_stripes = manifest.stripes.size();
+  auto const padded = manifest.paddedSize();
+  auto const unit = manifest.stripe_unit;
+  auto const base = image.getBuffer();
+
+  assert(num_stripes > 0 && "Must have at least one stripe");
+  assert(image.getOffset() + padded <= image.getCapacity() && "Image too small");
+
+  std::memset(base + manifest.payload_size, 0, padded - manifest.payload_size);
+
+  // Drop any previous manifest first: its stripes are about to be overwritten
+  // and it must not describe a mix of old and new data if this write fails
+  if (::unlink(manifest_path.c_str()) != 0 and errno != ENOENT) {
+    return false;
+  }
+
+  auto const wrote_all = forEachStripe(manifest, [&](std::size_t j) {
+    DirectFile file(manifest.stripes[j], eFileMode::Write);
+    if (not file.isOpen()) {
+      return false;
+    }
+    SerialSizeType file_off = 0;
+    for (SerialSizeType off = j * unit; off < padded; off += num_stripes * unit) {
+      auto const len = std::min(unit, padded - off);
+      if (not file.writeBlocks(base + off, len, file_off)) {
+        return false;
+      }
+      file_off += len;
+    }
+    return file.sync();
+  });
+
+  return wrote_all and manifest.write(manifest_path);
+}
+
+std::unique_ptr<AlignedBuffer> readStripes(std::string const& manifest_path) {
+  StripeManifest manifest;
+  if (not StripeManifest::read(manifest_path, manifest)) {
+    return nullptr;
+  }
+
+  auto const num_stripes = manifest.stripes.size();
+  auto const padded = manifest.paddedSize();
+  auto const unit = manifest.stripe_unit;
+
+  auto image = std::make_unique<AlignedBuffer>(padded, manifest.block_size);
+  auto const base = image->getBlock();
+
+  auto const read_all = forEachStripe(manifest, [&](std::size_t j) {
+    DirectFile file(manifest.stripes[j], eFileMode::Read);
+    if (not file.isOpen() or file.fileSize() < manifest.stripeSize(j)) {
+      return false;
+    }
+    SerialSizeType file_off = 0;
+    for (SerialSizeType off = j * unit; off < padded; off += num_stripes * unit) {
+      auto const len = std::min(unit, padded - off);
+      if (not file.readBlocks(base + off, len, file_off)) {
+        return false;
+      }
+      file_off += len;
+    }
+    return true;
+  });
+
+  if (not read_all) {
+    return nullptr;
+  }
+
+  image->setPayload(0, manifest.payload_size);
+  return image;
+}
+
+} /* end namespace serdes */
@@ -0,0 +1,116 @@
+/*
+//@HEADER
+// *****************************************************************************
+//
+//                                striped_file.h
+//                           DARMA Toolkit v. 1.0.0
+//                 DARMA/checkpoint => Serialization Library
+//
+// Copyright 2019 National Technology & Engineering Solutions of Sandia, LLC
+// (NTESS). Under the terms of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the following disclaimer.
+//
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// * Neither the name of the copyright holder nor the names of its
+//   contributors may be used to endorse or promote products derived from this
+//   software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact darma@sandia.gov
+//
+// *****************************************************************************
+//@HEADER
+*/
+
+#if !defined INCLUDED_SERDES_IO_STRIPED_FILE
+#define INCLUDED_SERDES_IO_STRIPED_FILE
+
+#include "serdes_common.h"
+#include "buffer/aligned_buffer.h"
+#include "io/direct_file.h"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace serdes {
+
+// Default number of contiguous bytes sent to one stripe before moving on to
+// the next one (must be a multiple of the block size)
+static constexpr SerialSizeType const default_stripe_unit = 1024 * 1024;
+
+/*
+ * Describes how a serialized payload is spread over several stripe files. Unit
+ * `i` of the (block-padded) payload lives in stripe `i % stripes.size()` at
+ * offset `(i / stripes.size()) * stripe_unit`. The manifest is removed before
+ * the stripes are rewritten and renamed into place only after every stripe is
+ * durable, so its presence marks a complete checkpoint.
+ */
+struct StripeManifest {
+  static constexpr int const manifest_version = 1;
+
+  SerialSizeType payload_size = 0;
+  SerialSizeType block_size = default_block_size;
+  SerialSizeType stripe_unit = default_stripe_unit;
+  std::vector<std::string> stripes;
+
+  // Size of the payload rounded up to whole blocks, as it is laid out on disk
+  SerialSizeType paddedSize() const {
+    return roundUpToBlock(payload_size, block_size);
+  }
+
+  // Number of bytes that stripe `j` holds
+  SerialSizeType stripeSize(std::size_t const j) const;
+
+  bool write(std::string const& path) const;
+  static bool read(std::string const& path, StripeManifest& manifest);
+
+  static std::string manifestPath(
+    std::vector<std::string> const& dirs, std::string const& name
+  );
+  static std::string stripePath(
+    std::vector<std::string> const& dirs, std::string const& name,
+    std::size_t const j
+  );
+};
+
+/*
+ * Write the payload in `image` (block-aligned, zero padded to a whole block)
+ * round-robin across the stripe files named in `manifest`, one writer thread
+ * per stripe, and then the manifest itself to `manifest_path`.
+ */
+bool writeStripes(
+  StripeManifest const& manifest, std::string const& manifest_path,
+  AlignedBuffer& image
+);
+
+/*
+ * Read every stripe named by the manifest at `manifest_path` concurrently and
+ * reassemble the original payload. The returned buffer describes only the
+ * payload and can be handed directly to the Unpacker; nullptr on failure.
+ */
+std::unique_ptr<AlignedBuffer> readStripes(std::string const& manifest_path);
+
+} /* end namespace serdes */
+
+#endif /*INCLUDED_SERDES_IO_STRIPED_FILE*/
@@ -0,0 +1,213 @@
+/*
+//@HEADER
+// *****************************************************************************
+//
+//                             throttled_writer.cc
+//                           DARMA Toolkit v. 1.0.0
+//                 DARMA/checkpoint => Serialization Library
+//
+// Copyright 2019 National Technology & Engineering Solutions of Sandia, LLC
+// (NTESS). Under the terms of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the following disclaimer.
+//
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// * Neither the name of the copyright holder nor the names of its
+//   contributors may be used to endorse or promote products derived from this
+//   software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact darma@sandia.gov
+//
+// *****************************************************************************
+//@HEADER
+*/
+
+#include "serdes_common.h"
+#include "io/throttled_writer.h"
+#include "io/direct_file.h"
+
+#include <algorithm>
+
+namespace serdes {
+
+TokenBucket::TokenBucket(double const bytes_per_sec, SerialSizeType const burst)
+  : rate_(bytes_per_sec), burst_(static_cast<double>(burst)), tokens_(burst_),
+    last_(ClockType::now())
+{ }
+
+void TokenBucket::setRate(double const bytes_per_sec) {
+  std::lock_guard<std::mutex> guard(mutex_);
+  refill(ClockType::now());
+  rate_ = bytes_per_sec;
+}
+
+double TokenBucket::getRate() const {
+  std::lock_guard<std::mutex> guard(mutex_);
+  return rate_;
+}
+
+void TokenBucket::refill(ClockType::time_point const now) {
+  std::chrono::duration<double> const elapsed = now - last_;
+  tokens_ = std::min(burst_, tokens_ + elapsed.count() * rate_);
+  last_ = now;
+}
+
+void TokenBucket::acquire(SerialSizeType const bytes) {
+  double wait_sec = 0.0;
+  {
+    std::lock_guard<std::mutex> guard(mutex_);
+    if (rate_ <= 0.0) {
+      return;
+    }
+    refill(ClockType::now());
+    tokens_ -= static_cast<double>(bytes);
+    if (tokens_ < 0.0) {
+      wait_sec = -tokens_ / rate_;
+    }
+  }
+  if (wait_sec > 0.0) {
+    std::this_thread::sleep_for(std::chrono::duration<double>(wait_sec));
+  }
+}
+
+ThrottledWriter::ThrottledWriter(
+  double const max_bytes_per_sec, ProgressFnType progress,
+  double const target_progress, std::chrono::milliseconds const adjust_interval
+) : max_rate_(max_bytes_per_sec), progress_(progress),
+    target_progress_(target_progress), adjust_interval_(adjust_interval),
+    last_adjust_(ClockType::now()),
+    bucket_(max_bytes_per_sec, default_chunk),
+    thread_([this]{ run(); })
+{ }
+
+ThrottledWriter::~ThrottledWriter() {
+  drain();
+  {
+    std::lock_guard<std::mutex> guard(mutex_);
+    stop_ = true;
+  }
+  cv_.notify_all();
+  thread_.join();
+}
+
+void ThrottledWriter::enqueue(
+  std::string const& path, ImagePtrType image, DoneFnType done,
+  AlignedBufferPool* pool
+) {
+  {
+    std::lock_guard<std::mutex> guard(mutex_);
+    queue_.push_back(Job{path, std::move(image), done, pool});
+  }
+  cv_.notify_one();
+}
+
+void ThrottledWriter::drain() {
+  std::unique_lock<std::mutex> lock(mutex_);
+  idle_cv_.wait(lock, [this]{ return queue_.empty() and not busy_; });
+}
+
+void ThrottledWriter::setMaxRate(double const max_bytes_per_sec) {
+  std::lock_guard<std::mutex> guard(mutex_);
+  max_rate_ = max_bytes_per_sec;
+  bucket_.setRate(max_rate_ * scale_);
+}
+
+double ThrottledWriter::getMaxRate() const {
+  std::lock_guard<std::mutex> guard(mutex_);
+  return max_rate_;
+}
+
+std::size_t ThrottledWriter::getNumFailed() const {
+  std::lock_guard<std::mutex> guard(mutex_);
+  return failed_;
+}
+
+void ThrottledWriter::adjust() {
+  auto const now = ClockType::now();
+  if (not progress_ or now - last_adjust_ < adjust_interval_) {
+    return;
+  }
+  last_adjust_ = now;
+
+  // AIMD on the fraction of the cap we allow ourselves
+  static constexpr double const min_scale = 0.05;
+  auto const progress = progress_();
+
+  std::lock_guard<std::mutex> guard(mutex_);
+  if (progress < target_progress_) {
+    scale_ = std::max(min_scale, scale_ * 0.5);
+  } else {
+    scale_ = std::min(1.0, scale_ + 0.1);
+  }
+  bucket_.setRate(max_rate_ * scale_);
+
+  debug_serdes(
+    "ThrottledWriter: progress=%f, scale=%f, rate=%f\n",
+    progress, scale_, max_rate_ * scale_
+  );
+}
+
+void ThrottledWriter::beforeChunk(SerialSizeType const len) {
+  adjust();
+  bucket_.acquire(len);
+}
+
+void ThrottledWriter::run() {
+  while (true) {
+    Job job;
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      cv_.wait(lock, [this]{ return stop_ or not queue_.empty(); });
+      if (queue_.empty()) {
+        return;
+      }
+      job = std::move(queue_.front());
+      queue_.pop_front();
+      busy_ = true;
+    }
+
+    auto const success = writeFileImage(
+      job.path, *job.image,
+      [this](SerialSizeType len){ beforeChunk(len); },
+      default_chunk
+    );
+
+    if (job.pool != nullptr) {
+      job.pool->release(std::move(job.image));
+    }
+    job.image = nullptr;
+
+    if (job.done) {
+      job.done(success);
+    }
+
+    {
+      std::lock_guard<std::mutex> guard(mutex_);
+      busy_ = false;
+      failed_ += success ? 0 : 1;
+    }
+    idle_cv_.notify_all();
+  }
+}
+
+} /* end namespace serdes */
@@ -0,0 +1,168 @@
+/*
+//@HEADER
+// *****************************************************************************
+//
+//                              throttled_writer.h
+//                           DARMA Toolkit v. 1.0.0
+//                 DARMA/checkpoint => Serialization Library
+//
+// Copyright 2019 National Technology & Engineering Solutions of Sandia, LLC
+// (NTESS). Under the terms of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the following disclaimer.
+//
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// * Neither the name of the copyright holder nor the names of its
+//   contributors may be used to endorse or promote products derived from this
+//   software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact darma@sandia.gov
+//
+// *****************************************************************************
+//@HEADER
+*/
+
+#if !defined INCLUDED_SERDES_IO_THROTTLED_WRITER
+#define INCLUDED_SERDES_IO_THROTTLED_WRITER
+
+#include "serdes_common.h"
+#include "buffer/aligned_buffer.h"
+#include "io/direct_file.h"
+
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+
+namespace serdes {
+
+/*
+ * Classic token bucket: tokens (bytes) accrue at `rate` per second up to
+ * `burst`. acquire() consumes tokens and sleeps off any deficit, so the
+ * long-run throughput never exceeds the configured rate. A rate of zero means
+ * unlimited.
+ */
+struct TokenBucket {
+  using ClockType = std::chrono::steady_clock;
+
+  TokenBucket(double const bytes_per_sec, SerialSizeType const burst);
+
+  void setRate(double const bytes_per_sec);
+  double getRate() const;
+  void acquire(SerialSizeType const bytes);
+
+private:
+  void refill(ClockType::time_point const now);
+
+private:
+  double rate_ = 0.0;
+  double burst_ = 0.0;
+  double tokens_ = 0.0;
+  ClockType::time_point last_;
+  mutable std::mutex mutex_;
+};
+
+/*
+ * Writes packed checkpoint images on a background thread at a bounded rate so
+ * flushing does not compete with the application for network and memory
+ * bandwidth.
+ *
+ * The optional progress callback reports the application's current progress
+ * rate relative to its unperturbed baseline (1.0 = no slowdown). It is polled
+ * every adjust interval: when progress drops below the target the write rate
+ * is cut multiplicatively; otherwise it recovers additively toward the cap.
+ */
+struct ThrottledWriter {
+  using ProgressFnType = std::function<double()>;
+  using ImagePtrType = std::unique_ptr<AlignedBuffer>;
+  using DoneFnType = std::function<void(bool success)>;
+  using ClockType = TokenBucket::ClockType;
+
+  // Bytes written between token acquisitions
+  static constexpr SerialSizeType const default_chunk = 1024 * 1024;
+
+  explicit ThrottledWriter(
+    double const max_bytes_per_sec, ProgressFnType progress = nullptr,
+    double const target_progress = 0.95,
+    std::chrono::milliseconds const adjust_interval = std::chrono::milliseconds(100)
+  );
+  ThrottledWriter(ThrottledWriter const&) = delete;
+  ThrottledWriter& operator=(ThrottledWriter const&) = delete;
+  ~ThrottledWriter();
+
+  /*
+   * Queue a file image (see packFileImage) to be written to `path`. The image
+   * is released to `pool` (if given) once written; `done` is invoked on the
+   * writer thread with the outcome.
+   */
+  void enqueue(
+    std::string const& path, ImagePtrType image, DoneFnType done = nullptr,
+    AlignedBufferPool* pool = nullptr
+  );
+
+  // Block until every queued image has been written
+  void drain();
+
+  void setMaxRate(double const max_bytes_per_sec);
+  double getMaxRate() const;
+  double getCurrentRate() const { return bucket_.getRate(); }
+  std::size_t getNumFailed() const;
+
+private:
+  struct Job {
+    std::string path;
+    ImagePtrType image;
+    DoneFnType done;
+    AlignedBufferPool* pool = nullptr;
+  };
+
+  void run();
+  void beforeChunk(SerialSizeType const len);
+  void adjust();
+
+private:
+  double max_rate_ = 0.0;
+  double scale_ = 1.0;
+  ProgressFnType progress_ = nullptr;
+  double target_progress_ = 0.95;
+  std::chrono::milliseconds adjust_interval_;
+  ClockType::time_point last_adjust_;
+  TokenBucket bucket_;
+
+  std::deque<Job> queue_;
+  bool busy_ = false;
+  bool stop_ = false;
+  std::size_t failed_ = 0;
+  mutable std::mutex mutex_;
+  std::condition_variable cv_;
+  std::condition_variable idle_cv_;
+  std::thread thread_;
+};
+
+} /* end namespace serdes */
+
+#endif /*INCLUDED_SERDES_IO_THROTTLED_WRITER*/
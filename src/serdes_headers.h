@@ -48,14 +48,23 @@
 #include "serializers/serializers_headers.h"
 #include "dispatch/dispatch.h"
 #include "traits/serializable_traits.h"
+#include "dispatch/pack_plan.h"
 
 #include "container/array_serialize.h"
+#include "container/columnar_serialize.h"
+#include "container/dualview_serialize.h"
 #include "container/enum_serialize.h"
+#include "container/immutable_serialize.h"
 #include "container/list_serialize.h"
 #include "container/map_serialize.h"
 #include "container/string_serialize.h"
 #include "container/tuple_serialize.h"
 #include "container/vector_serialize.h"
 #include "container/view_serialize.h"
+#include "container/view_slice_plan.h"
+
+#include "io/file_serialize.h"
+#include "io/checkpoint_scheduler.h"
+#include "io/shm_store.h"
 
 #endif /*INCLUDED_SERDES_HEADERS*/
@@ -49,9 +49,12 @@
 
 #include <type_traits>
 #include <cstdlib>
+#include <limits>
 
 namespace serdes {
 
+struct StringTable;
+
 enum struct eSerializationMode : int8_t {
   None = 0,
   Unpacking = 1,
@@ -60,6 +63,15 @@ enum struct eSerializationMode : int8_t {
   Invalid = -1
 };
 
+/*
+ * Wire encoding of size prefixes and opt-in integer fields: fixed-width, or
+ * compact variable-length (LEB128, zigzag for signed values)
+ */
+enum struct eWireMode : uint8_t {
+  Fixed = 0,
+  Compact = 1
+};
+
 struct Serializer {
   using ModeType = eSerializationMode;
 
@@ -70,16 +82,35 @@ struct Serializer {
   bool isPacking() const { return cur_mode_ == ModeType::Packing; }
   bool isUnpacking() const { return cur_mode_ == ModeType::Unpacking; }
 
+  eWireMode getWireMode() const { return wire_mode_; }
+  void setWireMode(eWireMode const in_wire_mode) { wire_mode_ = in_wire_mode; }
+  bool isCompact() const { return wire_mode_ == eWireMode::Compact; }
+
+  // Per-message string table for interning, attached in compact wire mode
+  StringTable* getStringTable() const { return string_table_; }
+  void setStringTable(StringTable* in_table) { string_table_ = in_table; }
+
   template <typename SerializerT, typename T>
   static void contiguousTyped(SerializerT& serdes, T* ptr, SerialSizeType num_elms) {
     serdes.contiguousBytes(static_cast<void*>(ptr), sizeof(T), num_elms);
   }
 
+  // Declares `len` bytes at `ptr` as storage owned by `owner` (e.g., a
+  // container's heap buffer); only PlanRecorder tracks ownership
+  void addOwnedStorage(void const*, void const*, SerialSizeType) { }
+
   SerialByteType* getBuffer() const { return nullptr; }
   SerialByteType* getSpotIncrement(SerialSizeType const inc) { return nullptr; }
 
+  // Bytes left behind the memory cursor; unbounded when there is none
+  SerialSizeType getRemaining() const {
+    return std::numeric_limits<SerialSizeType>::max();
+  }
+
 protected:
   ModeType cur_mode_ = ModeType::Invalid;
+  eWireMode wire_mode_ = eWireMode::Fixed;
+  StringTable* string_table_ = nullptr;
 };
 
 } /* end namespace serdes */
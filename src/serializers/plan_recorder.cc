@@ -0,0 +1,153 @@
+/*
+//@HEADER
+// *****************************************************************************
+//
+//                               plan_recorder.cc
+//                           DARMA Toolkit v. 1.0.0
+//                 DARMA/checkpoint => Serialization Library
+//
+// Copyright 2019 National Technology & Engineering Solutions of Sandia, LLC
+// (NTESS). Under the terms of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the following disclaimer.
+//
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// * Neither the name of the copyright holder nor the names of its
+//   contributors may be used to endorse or promote products derived from this
+//   software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact darma@sandia.gov
+//
+// *****************************************************************************
+//@HEADER
+*/
+
+#include "serdes_common.h"
+#include "plan_recorder.h"
+
+#include <cstring>
+
+namespace serdes {
+
+void PackPlan::clear() {
+  segments_.clear();
+  literals_.clear();
+  size_ = 0;
+}
+
+void PackPlan::appendRange(SerialByteType const* src, SerialSizeType len) {
+  // Merge with the previous range when the bytes are contiguous in memory
+  if (not segments_.empty()) {
+    auto& last = segments_.back();
+    if (last.src != nullptr and last.src + last.len == src) {
+      last.len += len;
+      size_ += len;
+      return;
+    }
+  }
+  Segment seg;
+  seg.src = src;
+  seg.len = len;
+  segments_.push_back(seg);
+  size_ += len;
+}
+
+void PackPlan::appendLiteral(SerialByteType const* src, SerialSizeType len) {
+  auto const offset = static_cast<SerialSizeType>(literals_.size());
+  literals_.insert(literals_.end(), src, src + len);
+
+  if (not segments_.empty()) {
+    auto& last = segments_.back();
+    if (last.src == nullptr and last.literal_offset + last.len == offset) {
+      last.len += len;
+      size_ += len;
+      return;
+    }
+  }
+  Segment seg;
+  seg.len = len;
+  seg.literal_offset = offset;
+  segments_.push_back(seg);
+  size_ += len;
+}
+
+void PackPlan::replay(SerialByteType* dst) const {
+  auto const literals = literals_.data();
+  for (auto&& seg : segments_) {
+    auto const src = seg.src ? seg.src : literals + seg.literal_offset;
+    std::memcpy(dst, src, seg.len);
+    dst += seg.len;
+  }
+}
+
+PlanRecorder::PlanRecorder(
+  PackPlan& in_plan, void const* object, SerialSizeType size
+) : Serializer(ModeType::Packing), plan_(in_plan)
+{
+  auto const begin = reinterpret_cast<std::uintptr_t>(object);
+  owned_[begin] = begin + size;
+}
+
+bool PlanRecorder::isOwned(
+  std::uintptr_t const begin, std::uintptr_t const end
+) const {
+  auto it = owned_.upper_bound(begin);
+  if (it == owned_.begin()) {
+    return false;
+  }
+  --it;
+  return end <= it->second;
+}
+
+void PlanRecorder::addOwnedStorage(
+  void const* owner, void const* ptr, SerialSizeType len
+) {
+  // Storage only belongs to the object if its owner does (a temporary
+  // container's buffer does not); nested and repeated regions are skipped
+  auto const owner_addr = reinterpret_cast<std::uintptr_t>(owner);
+  auto const begin = reinterpret_cast<std::uintptr_t>(ptr);
+  auto const end = begin + len;
+  if (len > 0 and isOwned(owner_addr, owner_addr + 1) and
+      not isOwned(begin, end)) {
+    owned_[begin] = end;
+  }
+}
+
+void PlanRecorder::contiguousBytes(
+  void* ptr, SerialSizeType size, SerialSizeType num_elms
+) {
+  SerialSizeType const len = size * num_elms;
+  if (len == 0) {
+    return;
+  }
+
+  auto const begin = reinterpret_cast<std::uintptr_t>(ptr);
+  auto const bytes = static_cast<SerialByteType const*>(ptr);
+  if (isOwned(begin, begin + len)) {
+    plan_.appendRange(bytes, len);
+  } else {
+    plan_.appendLiteral(bytes, len);
+  }
+}
+
+} /* end namespace serdes */
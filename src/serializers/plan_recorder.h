@@ -0,0 +1,117 @@
+/*
+//@HEADER
+// *****************************************************************************
+//
+//                               plan_recorder.h
+//                           DARMA Toolkit v. 1.0.0
+//                 DARMA/checkpoint => Serialization Library
+//
+// Copyright 2019 National Technology & Engineering Solutions of Sandia, LLC
+// (NTESS). Under the terms of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the following disclaimer.
+//
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// * Neither the name of the copyright holder nor the names of its
+//   contributors may be used to endorse or promote products derived from this
+//   software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact darma@sandia.gov
+//
+// *****************************************************************************
+//@HEADER
+*/
+
+#if !defined INCLUDED_SERDES_PLAN_RECORDER
+#define INCLUDED_SERDES_PLAN_RECORDER
+
+#include "serdes_common.h"
+#include "base_serializer.h"
+
+#include <cstdint>
+#include <map>
+#include <vector>
+
+namespace serdes {
+
+/*
+ * A recorded packing program: the ordered list of byte ranges that one
+ * traversal of an object copied out. Replaying it reproduces the packed bytes
+ * with a plain memcpy loop and no dispatch.
+ *
+ * Ranges are kept by address, so a plan is bound to the object it was
+ * recorded from and valid only while that object's shape (container sizes and
+ * allocations) is unchanged. Bytes that do not belong to the object, such as
+ * size prefixes and other temporaries, are captured by value.
+ */
+struct PackPlan {
+  struct Segment {
+    SerialByteType const* src = nullptr;  // nullptr: bytes are in literals_
+    SerialSizeType len = 0;
+    SerialSizeType literal_offset = 0;
+  };
+
+  SerialSizeType getSize() const { return size_; }
+  std::size_t getNumSegments() const { return segments_.size(); }
+  bool empty() const { return segments_.empty(); }
+
+  void clear();
+  void replay(SerialByteType* dst) const;
+
+  void appendRange(SerialByteType const* src, SerialSizeType len);
+  void appendLiteral(SerialByteType const* src, SerialSizeType len);
+
+private:
+  std::vector<Segment> segments_;
+  std::vector<SerialByteType> literals_;
+  SerialSizeType size_ = 0;
+};
+
+/*
+ * Serializer that records a PackPlan instead of packing. It runs in packing
+ * mode so serialize() functions take their packing path, but exposes no
+ * memory cursor so every byte range reaches contiguousBytes.
+ *
+ * Only bytes inside storage known to belong to the object are recorded by
+ * address: the object itself, plus any storage declared through
+ * addOwnedStorage (vector and string buffers, container elements) by an owner
+ * that already belongs to it. Everything else is copied into the plan.
+ */
+struct PlanRecorder : Serializer {
+  PlanRecorder(PackPlan& in_plan, void const* object, SerialSizeType size);
+
+  void contiguousBytes(void* ptr, SerialSizeType size, SerialSizeType num_elms);
+  void addOwnedStorage(void const* owner, void const* ptr, SerialSizeType len);
+
+private:
+  bool isOwned(std::uintptr_t const begin, std::uintptr_t const end) const;
+
+private:
+  PackPlan& plan_;
+  // Disjoint owned regions: begin address -> end address
+  std::map<std::uintptr_t, std::uintptr_t> owned_;
+};
+
+} /* end namespace serdes */
+
+#endif /*INCLUDED_SERDES_PLAN_RECORDER*/
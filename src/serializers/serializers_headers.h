@@ -50,5 +50,8 @@
 #include "sizer.h"
 #include "packer.h"
 #include "unpacker.h"
+#include "plan_recorder.h"
+#include "varint.h"
+#include "string_table.h"
 
 #endif /*INCLUDED_SERDES_SERIALIZERS_HEADERS*/
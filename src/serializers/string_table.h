@@ -0,0 +1,80 @@
+/*
+//@HEADER
+// *****************************************************************************
+//
+//                                string_table.h
+//                           DARMA Toolkit v. 1.0.0
+//                 DARMA/checkpoint => Serialization Library
+//
+// Copyright 2019 National Technology & Engineering Solutions of Sandia, LLC
+// (NTESS). Under the terms of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the following disclaimer.
+//
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// * Neither the name of the copyright holder nor the names of its
+//   contributors may be used to endorse or promote products derived from this
+//   software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact darma@sandia.gov
+//
+// *****************************************************************************
+//@HEADER
+*/
+
+#if !defined INCLUDED_SERDES_STRING_TABLE
+#define INCLUDED_SERDES_STRING_TABLE
+
+#include "serdes_common.h"
+
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace serdes {
+
+/*
+ * A per-message table of interned strings. Strings serialized with
+ * serializeInterned are written in full the first time a message contains
+ * them and by index afterwards. Each sizing, packing and unpacking pass owns
+ * a fresh table, so all passes see the same sequence of first occurrences.
+ */
+struct StringTable {
+  // Index of `str`, and whether this call added it to the table
+  std::pair<SerialSizeType, bool> intern(std::string const& str);
+
+  // Append a string unpacked in full; false if it is already in the table
+  bool add(std::string const& str);
+  // String at a wire index; nullptr if the index is past the table
+  std::string const* get(SerialSizeType idx) const;
+  SerialSizeType size() const { return strings_.size(); }
+
+private:
+  std::unordered_map<std::string, SerialSizeType> index_;
+  std::vector<std::string> strings_;
+};
+
+} /* end namespace serdes */
+
+#endif /*INCLUDED_SERDES_STRING_TABLE*/
@@ -52,7 +52,7 @@
 namespace serdes {
 
 Unpacker::Unpacker(SerialByteType* buf, SerialSizeType const& size)
-  : MemorySerializer(ModeType::Unpacking, buf)
+  : MemorySerializer(ModeType::Unpacking, buf), end_(buf + size)
 {
   debug_serdes("Unpacker: size=%ld, start_=%p, cur_=%p\n", size, start_, cur_);
 }
@@ -54,6 +54,14 @@ struct Unpacker : MemorySerializer {
   Unpacker(SerialByteType* buf, SerialSizeType const& size);
 
   void contiguousBytes(void* ptr, SerialSizeType size, SerialSizeType num_elms);
+
+  SerialSizeType getRemaining() const {
+    return cur_ < end_ ? static_cast<SerialSizeType>(end_ - cur_) : 0;
+  }
+
+private:
+  // One past the last byte of the buffer being unpacked
+  SerialByteType* end_ = nullptr;
 };
 
 } /* end namespace serdes */
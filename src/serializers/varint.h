@@ -0,0 +1,168 @@
+/*
+//@HEADER
+// *****************************************************************************
+//
+//                                   varint.h
+//                           DARMA Toolkit v. 1.0.0
+//                 DARMA/checkpoint => Serialization Library
+//
+// Copyright 2019 National Technology & Engineering Solutions of Sandia, LLC
+// (NTESS). Under the terms of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the following disclaimer.
+//
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// * Neither the name of the copyright holder nor the names of its
+//   contributors may be used to endorse or promote products derived from this
+//   software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact darma@sandia.gov
+//
+// *****************************************************************************
+//@HEADER
+*/
+
+#if !defined INCLUDED_SERDES_VARINT
+#define INCLUDED_SERDES_VARINT
+
+#include "serdes_common.h"
+
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+namespace serdes {
+
+static constexpr std::size_t const max_varint_bytes = 10;
+
+inline std::size_t varintLength(uint64_t raw) {
+  std::size_t len = 1;
+  while (raw >= 0x80) {
+    raw >>= 7;
+    len++;
+  }
+  return len;
+}
+
+inline std::size_t encodeVarint(uint64_t raw, SerialByteType* out) {
+  std::size_t len = 0;
+  while (raw >= 0x80) {
+    out[len++] = static_cast<SerialByteType>((raw & 0x7F) | 0x80);
+    raw >>= 7;
+  }
+  out[len++] = static_cast<SerialByteType>(raw);
+  return len;
+}
+
+// Decode one varint from at most `avail` bytes; returns 0 if it is truncated
+inline std::size_t decodeVarint(
+  SerialByteType const* in, std::size_t avail, uint64_t& raw
+) {
+  raw = 0;
+  std::size_t len = 0;
+  for (unsigned shift = 0; len < avail; shift += 7) {
+    auto const byte = static_cast<uint8_t>(in[len++]);
+    raw |= static_cast<uint64_t>(byte & 0x7F) << shift;
+    if ((byte & 0x80) == 0 or len == max_varint_bytes) {
+      return len;
+    }
+  }
+  return 0;
+}
+
+/*
+ * Map integers to the unsigned varint payload: signed values are zigzag
+ * encoded so small magnitudes of either sign stay short
+ */
+template <typename IntT>
+inline uint64_t toVarintRaw(IntT val, std::true_type /*signed*/) {
+  auto const v = static_cast<int64_t>(val);
+  return (static_cast<uint64_t>(v) << 1) ^ static_cast<uint64_t>(v >> 63);
+}
+
+template <typename IntT>
+inline uint64_t toVarintRaw(IntT val, std::false_type) {
+  return static_cast<uint64_t>(val);
+}
+
+template <typename IntT>
+inline uint64_t toVarintRaw(IntT val) {
+  return toVarintRaw(val, std::is_signed<IntT>{});
+}
+
+template <typename IntT>
+inline IntT fromVarintRaw(uint64_t raw, std::true_type /*signed*/) {
+  return static_cast<IntT>(
+    static_cast<int64_t>(raw >> 1) ^ -static_cast<int64_t>(raw & 1)
+  );
+}
+
+template <typename IntT>
+inline IntT fromVarintRaw(uint64_t raw, std::false_type) {
+  return static_cast<IntT>(raw);
+}
+
+template <typename IntT>
+inline IntT fromVarintRaw(uint64_t raw) {
+  return fromVarintRaw<IntT>(raw, std::is_signed<IntT>{});
+}
+
+/*
+ * Decode `num` varints from `len` bytes, eight one-byte varints at a time when
+ * possible; returns false if the input ends first
+ */
+template <typename IntT>
+inline bool decodeVarintBatch(
+  SerialByteType const* in, std::size_t len, IntT* out, std::size_t num
+) {
+  constexpr uint64_t const continuation_bits = 0x8080808080808080ULL;
+
+  std::size_t pos = 0;
+  std::size_t i = 0;
+  while (i < num) {
+    if (pos + 8 <= len and i + 8 <= num) {
+      uint64_t word;
+      std::memcpy(&word, in + pos, sizeof(word));
+      if ((word & continuation_bits) == 0) {
+        for (std::size_t k = 0; k < 8; k++) {
+          out[i + k] = fromVarintRaw<IntT>(static_cast<uint8_t>(in[pos + k]));
+        }
+        i += 8;
+        pos += 8;
+        continue;
+      }
+    }
+    uint64_t raw = 0;
+    auto const consumed = decodeVarint(in + pos, len - pos, raw);
+    if (consumed == 0) {
+      return false;
+    }
+    pos += consumed;
+    out[i++] = fromVarintRaw<IntT>(raw);
+  }
+  return true;
+}
+
+} /* end namespace serdes */
+
+#endif /*INCLUDED_SERDES_VARINT*/
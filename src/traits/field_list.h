@@ -0,0 +1,300 @@
+/*
+//@HEADER
+// *****************************************************************************
+//
+//                                 field_list.h
+//                           DARMA Toolkit v. 1.0.0
+//                 DARMA/checkpoint => Serialization Library
+//
+// Copyright 2019 National Technology & Engineering Solutions of Sandia, LLC
+// (NTESS). Under the terms of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the following disclaimer.
+//
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// * Neither the name of the copyright holder nor the names of its
+//   contributors may be used to endorse or promote products derived from this
+//   software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact darma@sandia.gov
+//
+// *****************************************************************************
+//@HEADER
+*/
+
+#if !defined INCLUDED_SERDES_FIELD_LIST
+#define INCLUDED_SERDES_FIELD_LIST
+
+#include "serdes_common.h"
+
+#include <cstddef>
+#include <type_traits>
+
+namespace serdes {
+
+/*
+ * A compile-time description of one data member of T: its type and its byte
+ * offset inside T (T must be standard-layout so offsetof is well-defined)
+ */
+template <typename T, typename MemberT, std::size_t Offset>
+struct Field {
+  using ClassType = T;
+  using MemberType = MemberT;
+
+  static constexpr std::size_t const offset = Offset;
+  static constexpr std::size_t const size = sizeof(MemberT);
+
+  static MemberT& get(T& t) {
+    return *reinterpret_cast<MemberT*>(
+      reinterpret_cast<SerialByteType*>(&t) + Offset
+    );
+  }
+};
+
+template <typename T, typename MemberT, std::size_t Offset>
+constexpr std::size_t const Field<T, MemberT, Offset>::offset;
+
+template <typename T, typename MemberT, std::size_t Offset>
+constexpr std::size_t const Field<T, MemberT, Offset>::size;
+
+template <typename... FieldsT>
+struct FieldList {
+  static constexpr bool const declared = true;
+  static constexpr std::size_t const num_fields = sizeof...(FieldsT);
+};
+
+template <typename... FieldsT>
+constexpr bool const FieldList<FieldsT...>::declared;
+
+template <typename... FieldsT>
+constexpr std::size_t const FieldList<FieldsT...>::num_fields;
+
+/*
+ * Member list of T; specialized through SERDES_FIELDS. The primary template
+ * means no list has been declared.
+ */
+template <typename T>
+struct Fields {
+  static constexpr bool const declared = false;
+};
+
+template <typename T>
+struct hasFields : std::integral_constant<bool, Fields<T>::declared> { };
+
+template <typename T>
+struct FieldsArityExceeded {
+  static_assert(sizeof(T) == 0, "SERDES_FIELDS supports at most 64 members");
+  using type = void;
+};
+
+/*
+ * Invoke fn.template operator()<FieldT>() for each field in declaration order
+ */
+template <typename FnT>
+inline void forEachField(FnT&&, FieldList<>) { }
+
+template <typename FnT, typename FieldT, typename... Rest>
+inline void forEachField(FnT&& fn, FieldList<FieldT, Rest...>) {
+  fn.template operator()<FieldT>();
+  forEachField(fn, FieldList<Rest...>{});
+}
+
+template <typename T, typename FnT>
+inline void forEachField(FnT&& fn) {
+  forEachField(fn, Fields<T>{});
+}
+
+} /* end namespace serdes */
+
+#define SERDES_FIELD(TYPE, FIELD)                                       \
+  ::serdes::Field<TYPE, decltype(TYPE::FIELD), offsetof(TYPE, FIELD)>
+
+#define SERDES_FIELDS_CAT_(A, B) A##B
+#define SERDES_FIELDS_CAT(A, B) SERDES_FIELDS_CAT_(A, B)
+
+#define SERDES_FIELDS_NARG_(                                            \
+  _1, _2, _3, _4, _5, _6, _7, _8, _9, _10, _11, _12, _13, _14, _15,     \
+  _16, _17, _18, _19, _20, _21, _22, _23, _24, _25, _26, _27, _28,      \
+  _29, _30, _31, _32, _33, _34, _35, _36, _37, _38, _39, _40, _41,      \
+  _42, _43, _44, _45, _46, _47, _48, _49, _50, _51, _52, _53, _54,      \
+  _55, _56, _57, _58, _59, _60, _61, _62, _63, _64, _65, _66, _67,      \
+  _68, _69, _70, _71, _72, N, ...                                       \
+) N
+#define SERDES_FIELDS_NARG(...)                                         \
+  SERDES_FIELDS_NARG_(                                                  \
+    __VA_ARGS__,                                                        \
+    TOO_MANY, TOO_MANY, TOO_MANY, TOO_MANY, TOO_MANY, TOO_MANY,         \
+    TOO_MANY, TOO_MANY, 64, 63, 62, 61, 60, 59, 58, 57, 56, 55, 54,     \
+    53, 52, 51, 50, 49, 48, 47, 46, 45, 44, 43, 42, 41, 40, 39, 38,     \
+    37, 36, 35, 34, 33, 32, 31, 30, 29, 28, 27, 26, 25, 24, 23, 22,     \
+    21, 20, 19, 18, 17, 16, 15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4,   \
+    3, 2, 1                                                             \
+  )
+
+// Expands for more than 64 members so the error names the limit
+#define SERDES_FIELDS_MAP_TOO_MANY(T, ...)                              \
+  ::serdes::FieldsArityExceeded<T>::type
+
+#define SERDES_FIELDS_MAP_1(T, F) SERDES_FIELD(T, F)
+#define SERDES_FIELDS_MAP_2(T, F, ...) \
+  SERDES_FIELD(T, F), SERDES_FIELDS_MAP_1(T, __VA_ARGS__)
+#define SERDES_FIELDS_MAP_3(T, F, ...) \
+  SERDES_FIELD(T, F), SERDES_FIELDS_MAP_2(T, __VA_ARGS__)
+#define SERDES_FIELDS_MAP_4(T, F, ...) \
+  SERDES_FIELD(T, F), SERDES_FIELDS_MAP_3(T, __VA_ARGS__)
+#define SERDES_FIELDS_MAP_5(T, F, ...) \
+  SERDES_FIELD(T, F), SERDES_FIELDS_MAP_4(T, __VA_ARGS__)
+#define SERDES_FIELDS_MAP_6(T, F, ...) \
+  SERDES_FIELD(T, F), SERDES_FIELDS_MAP_5(T, __VA_ARGS__)
+#define SERDES_FIELDS_MAP_7(T, F, ...) \
+  SERDES_FIELD(T, F), SERDES_FIELDS_MAP_6(T, __VA_ARGS__)
+#define SERDES_FIELDS_MAP_8(T, F, ...) \
+  SERDES_FIELD(T, F), SERDES_FIELDS_MAP_7(T, __VA_ARGS__)
+#define SERDES_FIELDS_MAP_9(T, F, ...) \
+  SERDES_FIELD(T, F), SERDES_FIELDS_MAP_8(T, __VA_ARGS__)
+#define SERDES_FIELDS_MAP_10(T, F, ...) \
+  SERDES_FIELD(T, F), SERDES_FIELDS_MAP_9(T, __VA_ARGS__)
+#define SERDES_FIELDS_MAP_11(T, F, ...) \
+  SERDES_FIELD(T, F), SERDES_FIELDS_MAP_10(T, __VA_ARGS__)
+#define SERDES_FIELDS_MAP_12(T, F, ...) \
+  SERDES_FIELD(T, F), SERDES_FIELDS_MAP_11(T, __VA_ARGS__)
+#define SERDES_FIELDS_MAP_13(T, F, ...) \
+  SERDES_FIELD(T, F), SERDES_FIELDS_MAP_12(T, __VA_ARGS__)
+#define SERDES_FIELDS_MAP_14(T, F, ...) \
+  SERDES_FIELD(T, F), SERDES_FIELDS_MAP_13(T, __VA_ARGS__)
+#define SERDES_FIELDS_MAP_15(T, F, ...) \
+  SERDES_FIELD(T, F), SERDES_FIELDS_MAP_14(T, __VA_ARGS__)
+#define SERDES_FIELDS_MAP_16(T, F, ...) \
+  SERDES_FIELD(T, F), SERDES_FIELDS_MAP_15(T, __VA_ARGS__)
+#define SERDES_FIELDS_MAP_17(T, F, ...) \
+  SERDES_FIELD(T, F), SERDES_FIELDS_MAP_16(T, __VA_ARGS__)
+#define SERDES_FIELDS_MAP_18(T, F, ...) \
+  SERDES_FIELD(T, F), SERDES_FIELDS_MAP_17(T, __VA_ARGS__)
+#define SERDES_FIELDS_MAP_19(T, F, ...) \
+  SERDES_FIELD(T, F), SERDES_FIELDS_MAP_18(T, __VA_ARGS__)
+#define SERDES_FIELDS_MAP_20(T, F, ...) \
+  SERDES_FIELD(T, F), SERDES_FIELDS_MAP_19(T, __VA_ARGS__)
+#define SERDES_FIELDS_MAP_21(T, F, ...) \
+  SERDES_FIELD(T, F), SERDES_FIELDS_MAP_20(T, __VA_ARGS__)
+#define SERDES_FIELDS_MAP_22(T, F, ...) \
+  SERDES_FIELD(T, F), SERDES_FIELDS_MAP_21(T, __VA_ARGS__)
+#define SERDES_FIELDS_MAP_23(T, F, ...) \
+  SERDES_FIELD(T, F), SERDES_FIELDS_MAP_22(T, __VA_ARGS__)
+#define SERDES_FIELDS_MAP_24(T, F, ...) \
+  SERDES_FIELD(T, F), SERDES_FIELDS_MAP_23(T, __VA_ARGS__)
+#define SERDES_FIELDS_MAP_25(T, F, ...) \
+  SERDES_FIELD(T, F), SERDES_FIELDS_MAP_24(T, __VA_ARGS__)
+#define SERDES_FIELDS_MAP_26(T, F, ...) \
+  SERDES_FIELD(T, F), SERDES_FIELDS_MAP_25(T, __VA_ARGS__)
+#define SERDES_FIELDS_MAP_27(T, F, ...) \
+  SERDES_FIELD(T, F), SERDES_FIELDS_MAP_26(T, __VA_ARGS__)
+#define SERDES_FIELDS_MAP_28(T, F, ...) \
+  SERDES_FIELD(T, F), SERDES_FIELDS_MAP_27(T, __VA_ARGS__)
+#define SERDES_FIELDS_MAP_29(T, F, ...) \
+  SERDES_FIELD(T, F), SERDES_FIELDS_MAP_28(T, __VA_ARGS__)
+#define SERDES_FIELDS_MAP_30(T, F, ...) \
+  SERDES_FIELD(T, F), SERDES_FIELDS_MAP_29(T, __VA_ARGS__)
+#define SERDES_FIELDS_MAP_31(T, F, ...) \
+  SERDES_FIELD(T, F), SERDES_FIELDS_MAP_30(T, __VA_ARGS__)
+#define SERDES_FIELDS_MAP_32(T, F, ...) \
+  SERDES_FIELD(T, F), SERDES_FIELDS_MAP_31(T, __VA_ARGS__)
+#define SERDES_FIELDS_MAP_33(T, F, ...) \
+  SERDES_FIELD(T, F), SERDES_FIELDS_MAP_32(T, __VA_ARGS__)
+#define SERDES_FIELDS_MAP_34(T, F, ...) \
+  SERDES_FIELD(T, F), SERDES_FIELDS_MAP_33(T, __VA_ARGS__)
+#define SERDES_FIELDS_MAP_35(T, F, ...) \
+  SERDES_FIELD(T, F), SERDES_FIELDS_MAP_34(T, __VA_ARGS__)
+#define SERDES_FIELDS_MAP_36(T, F, ...) \
+  SERDES_FIELD(T, F), SERDES_FIELDS_MAP_35(T, __VA_ARGS__)
+#define SERDES_FIELDS_MAP_37(T, F, ...) \
+  SERDES_FIELD(T, F), SERDES_FIELDS_MAP_36(T, __VA_ARGS__)
+#define SERDES_FIELDS_MAP_38(T, F, ...) \
+  SERDES_FIELD(T, F), SERDES_FIELDS_MAP_37(T, __VA_ARGS__)
+#define SERDES_FIELDS_MAP_39(T, F, ...) \
+  SERDES_FIELD(T, F), SERDES_FIELDS_MAP_38(T, __VA_ARGS__)
+#define SERDES_FIELDS_MAP_40(T, F, ...) \
+  SERDES_FIELD(T, F), SERDES_FIELDS_MAP_39(T, __VA_ARGS__)
+#define SERDES_FIELDS_MAP_41(T, F, ...) \
+  SERDES_FIELD(T, F), SERDES_FIELDS_MAP_40(T, __VA_ARGS__)
+#define SERDES_FIELDS_MAP_42(T, F, ...) \
+  SERDES_FIELD(T, F), SERDES_FIELDS_MAP_41(T, __VA_ARGS__)
+#define SERDES_FIELDS_MAP_43(T, F, ...) \
+  SERDES_FIELD(T, F), SERDES_FIELDS_MAP_42(T, __VA_ARGS__)
+#define SERDES_FIELDS_MAP_44(T, F, ...) \
+  SERDES_FIELD(T, F), SERDES_FIELDS_MAP_43(T, __VA_ARGS__)
+#define SERDES_FIELDS_MAP_45(T, F, ...) \
+  SERDES_FIELD(T, F), SERDES_FIELDS_MAP_44(T, __VA_ARGS__)
+#define SERDES_FIELDS_MAP_46(T, F, ...) \
+  SERDES_FIELD(T, F), SERDES_FIELDS_MAP_45(T, __VA_ARGS__)
+#define SERDES_FIELDS_MAP_47(T, F, ...) \
+  SERDES_FIELD(T, F), SERDES_FIELDS_MAP_46(T, __VA_ARGS__)
+#define SERDES_FIELDS_MAP_48(T, F, ...) \
+  SERDES_FIELD(T, F), SERDES_FIELDS_MAP_47(T, __VA_ARGS__)
+#define SERDES_FIELDS_MAP_49(T, F, ...) \
+  SERDES_FIELD(T, F), SERDES_FIELDS_MAP_48(T, __VA_ARGS__)
+#define SERDES_FIELDS_MAP_50(T, F, ...) \
+  SERDES_FIELD(T, F), SERDES_FIELDS_MAP_49(T, __VA_ARGS__)
+#define SERDES_FIELDS_MAP_51(T, F, ...) \
+  SERDES_FIELD(T, F), SERDES_FIELDS_MAP_50(T, __VA_ARGS__)
+#define SERDES_FIELDS_MAP_52(T, F, ...) \
+  SERDES_FIELD(T, F), SERDES_FIELDS_MAP_51(T, __VA_ARGS__)
+#define SERDES_FIELDS_MAP_53(T, F, ...) \
+  SERDES_FIELD(T, F), SERDES_FIELDS_MAP_52(T, __VA_ARGS__)
+#define SERDES_FIELDS_MAP_54(T, F, ...) \
+  SERDES_FIELD(T, F), SERDES_FIELDS_MAP_53(T, __VA_ARGS__)
+#define SERDES_FIELDS_MAP_55(T, F, ...) \
+  SERDES_FIELD(T, F), SERDES_FIELDS_MAP_54(T, __VA_ARGS__)
+#define SERDES_FIELDS_MAP_56(T, F, ...) \
+  SERDES_FIELD(T, F), SERDES_FIELDS_MAP_55(T, __VA_ARGS__)
+#define SERDES_FIELDS_MAP_57(T, F, ...) \
+  SERDES_FIELD(T, F), SERDES_FIELDS_MAP_56(T, __VA_ARGS__)
+#define SERDES_FIELDS_MAP_58(T, F, ...) \
+  SERDES_FIELD(T, F), SERDES_FIELDS_MAP_57(T, __VA_ARGS__)
+#define SERDES_FIELDS_MAP_59(T, F, ...) \
+  SERDES_FIELD(T, F), SERDES_FIELDS_MAP_58(T, __VA_ARGS__)
+#define SERDES_FIELDS_MAP_60(T, F, ...) \
+  SERDES_FIELD(T, F), SERDES_FIELDS_MAP_59(T, __VA_ARGS__)
+#define SERDES_FIELDS_MAP_61(T, F, ...) \
+  SERDES_FIELD(T, F), SERDES_FIELDS_MAP_60(T, __VA_ARGS__)
+#define SERDES_FIELDS_MAP_62(T, F, ...) \
+  SERDES_FIELD(T, F), SERDES_FIELDS_MAP_61(T, __VA_ARGS__)
+#define SERDES_FIELDS_MAP_63(T, F, ...) \
+  SERDES_FIELD(T, F), SERDES_FIELDS_MAP_62(T, __VA_ARGS__)
+#define SERDES_FIELDS_MAP_64(T, F, ...) \
+  SERDES_FIELD(T, F), SERDES_FIELDS_MAP_63(T, __VA_ARGS__)
+
+/*
+ * Declare the member list of TYPE (up to 64 members), at global scope:
+ *
+ *   SERDES_FIELDS(::my::Particle, x, y, z, id)
+ */
+#define SERDES_FIELDS(TYPE, ...)                                        \
+  namespace serdes {                                                    \
+    template <>                                                         \
+    struct Fields<TYPE> : FieldList<                                    \
+      SERDES_FIELDS_CAT(SERDES_FIELDS_MAP_, SERDES_FIELDS_NARG(__VA_ARGS__)) \
+        (TYPE, __VA_ARGS__)                                             \
+    > { };                                                              \
+  }
+
+#endif /*INCLUDED_SERDES_FIELD_LIST*/
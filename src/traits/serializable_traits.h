@@ -47,6 +47,7 @@
 
 #include "serdes_common.h"
 #include "serializers/serializers_headers.h"
+#include "traits/field_list.h"
 
 #include <cstdint>
 #include <cassert>
@@ -116,6 +117,11 @@ struct SerializableTraits {
   using has_nonintrustive_serialize
   = detection::is_detected<nonintrustive_serialize_t, T>;
 
+  template <typename U>
+  using serializedSize_t = decltype(std::declval<U const&>().serializedSize());
+  using has_serializedSize =
+    detection::is_detected_convertible<SerialSizeType, serializedSize_t, T>;
+
   template <typename U>
   using constructor_t = decltype(U());
   using has_default_constructor = detection::is_detected<constructor_t, T>;
@@ -184,9 +190,20 @@ struct SerializableTraits {
   static constexpr auto const has_serialize_function =
     has_serialize_instrusive or has_serialize_noninstrusive;
 
+  // This defines what it means to report its own serialized size
+  static constexpr auto const has_serialized_size = has_serializedSize::value;
+
+  // This defines what it means to have a declared member list
+  static constexpr auto const has_fields = hasFields<T>::value;
+
+  // This defines what it means to be serialized by its member list
+  static constexpr auto const has_fields_serialize =
+    has_fields and not has_serialize_function;
+
   // This defines what it means to be serializable
   static constexpr auto const is_serializable =
-    has_serialize_function and (is_default_constructible or is_reconstructible);
+    (has_serialize_function or has_fields) and
+    (is_default_constructible or is_reconstructible);
 
   static constexpr auto const is_parserdes =
     has_parserdes and not has_serialize_function;
@@ -0,0 +1,117 @@
+/*
+//@HEADER
+// *****************************************************************************
+//
+//                         test_checkpoint_scheduler.cc
+//                           DARMA Toolkit v. 1.0.0
+//                 DARMA/checkpoint => Serialization Library
+//
+// Copyright 2019 National Technology & Engineering Solutions of Sandia, LLC
+// (NTESS). Under the terms of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the following disclaimer.
+//
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// * Neither the name of the copyright holder nor the names of its
+//   contributors may be used to endorse or promote products derived from this
+//   software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact darma@sandia.gov
+//
+// *****************************************************************************
+//@HEADER
+*/
+
+#include <gtest/gtest.h>
+
+#include "test_harness.h"
+
+#include "serdes_headers.h"
+
+#include <cmath>
+#include <vector>
+
+namespace serdes { namespace tests { namespace unit {
+
+struct TestCheckpointScheduler : TestHarness { };
+
+TEST_F(TestCheckpointScheduler, test_young_daly_interval) {
+  // Young: sqrt(2*C*M)
+  EXPECT_DOUBLE_EQ(CheckpointScheduler::youngInterval(50.0, 3600.0), 600.0);
+
+  // Daly refines Young for C << M and saturates at M for C >= 2M
+  auto const daly = CheckpointScheduler::dalyInterval(50.0, 3600.0);
+  auto const ratio = 50.0 / 7200.0;
+  auto const expected =
+    600.0 * (1.0 + std::sqrt(ratio) / 3.0 + ratio / 9.0) - 50.0;
+  EXPECT_DOUBLE_EQ(daly, expected);
+  EXPECT_DOUBLE_EQ(CheckpointScheduler::dalyInterval(8000.0, 3600.0), 3600.0);
+}
+
+TEST_F(TestCheckpointScheduler, test_scheduler_tracks_state_size) {
+  CheckpointScheduler sched(3600.0, 1.0);
+
+  // Not calibrated yet: checkpoint right away to measure the cost
+  EXPECT_TRUE(sched.shouldCheckpointNow());
+
+  CheckpointCost cost;
+  cost.sizing = 1.0;
+  cost.packing = 2.0;
+  cost.writing = 7.0;
+  cost.bytes = 1000;
+  sched.recordCost(cost);
+
+  EXPECT_DOUBLE_EQ(sched.getPredictedCost(), 10.0);
+  EXPECT_DOUBLE_EQ(
+    sched.getInterval(), CheckpointScheduler::dalyInterval(10.0, 3600.0)
+  );
+  EXPECT_FALSE(sched.shouldCheckpointNow());
+
+  // Every phase, sizing included, scales with the state size
+  auto const before = sched.getInterval();
+  sched.setStateSize(2000);
+  EXPECT_DOUBLE_EQ(sched.getPredictedCost(), 20.0);
+  EXPECT_GT(sched.getInterval(), before);
+}
+
+TEST_F(TestCheckpointScheduler, test_scheduler_measures_checkpoint) {
+  CheckpointScheduler sched(1e-9);
+
+  std::vector<double> state(4096, 1.0);
+  SerialSizeType written = 0;
+  EXPECT_TRUE(sched.checkpoint(state, [&](Buffer& buf){
+    written = buf.getSize();
+    return true;
+  }));
+
+  EXPECT_EQ(written, sizeType(state));
+  EXPECT_EQ(sched.getLastCost().bytes, written);
+  EXPECT_GE(sched.getLastCost().total(), 0.0);
+
+  // Checkpointing is far more expensive than the MTBF: interval saturates at
+  // the MTBF and the scheduler asks for a checkpoint almost immediately
+  EXPECT_DOUBLE_EQ(sched.getInterval(), 1e-9);
+  while (not sched.shouldCheckpointNow()) { }
+}
+
+}}} // end namespace serdes::tests::unit
@@ -0,0 +1,237 @@
+/*
+//@HEADER
+// *****************************************************************************
+//
+//                               test_columnar.cc
+//                           DARMA Toolkit v. 1.0.0
+//                 DARMA/checkpoint => Serialization Library
+//
+// Copyright 2019 National Technology & Engineering Solutions of Sandia, LLC
+// (NTESS). Under the terms of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the following disclaimer.
+//
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// * Neither the name of the copyright holder nor the names of its
+//   contributors may be used to endorse or promote products derived from this
+//   software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact darma@sandia.gov
+//
+// *****************************************************************************
+//@HEADER
+*/
+
+#include <gtest/gtest.h>
+
+#include "test_harness.h"
+
+#include "serdes_headers.h"
+
+#include <cstring>
+#include <string>
+#include <vector>
+
+namespace userTest {
+
+struct Particle {
+  double x = 0., y = 0.;
+  int id = 0;
+  char kind = 0;
+
+  bool operator==(Particle const& p) const {
+    return x == p.x and y == p.y and id == p.id and kind == p.kind;
+  }
+};
+
+struct Sample {
+  int a = 0, b = 0, c = 0;
+  // padding here breaks the run
+  double d = 0.;
+  char e = 0;
+  // padding here breaks the run
+  double f = 0.;
+  std::string label;
+  float g = 0.f, h = 0.f;
+};
+
+struct SampleManual : Sample {
+  template <typename Serializer>
+  void serialize(Serializer& s) {
+    s | a | b | c | d | e | f | label | g | h;
+  }
+};
+
+// More members than the original 16-field limit of SERDES_FIELDS
+struct Wide {
+  int f0 = 0, f1 = 0, f2 = 0, f3 = 0, f4 = 0, f5 = 0, f6 = 0, f7 = 0;
+  int f8 = 0, f9 = 0, f10 = 0, f11 = 0, f12 = 0, f13 = 0, f14 = 0, f15 = 0;
+  std::string name;
+  double f16 = 0., f17 = 0., f18 = 0., f19 = 0.;
+};
+
+} // end namespace userTest
+
+SERDES_FIELDS(::userTest::Particle, x, y, id, kind)
+SERDES_FIELDS(::userTest::Sample, a, b, c, d, e, f, label, g, h)
+SERDES_FIELDS(
+  ::userTest::Wide, f0, f1, f2, f3, f4, f5, f6, f7, f8, f9, f10, f11, f12,
+  f13, f14, f15, name, f16, f17, f18, f19
+)
+
+namespace serdes { namespace tests { namespace unit {
+
+struct TestColumnar : TestHarness {
+  struct Cloud {
+    std::vector<::userTest::Particle> particles;
+
+    template <typename Serializer>
+    void serialize(Serializer& s) {
+      serializeColumnar(s, particles);
+    }
+  };
+};
+
+TEST_F(TestColumnar, test_field_list) {
+  using ::userTest::Particle;
+  using FieldsT = Fields<Particle>;
+
+  EXPECT_TRUE(hasFields<Particle>::value);
+  EXPECT_FALSE(hasFields<int>::value);
+  EXPECT_EQ(FieldsT::num_fields, 4u);
+
+  Particle p;
+  SERDES_FIELD(Particle, id)::get(p) = 12;
+  EXPECT_EQ(p.id, 12);
+}
+
+TEST_F(TestColumnar, test_columnar_vector) {
+  using ::userTest::Particle;
+
+  Cloud cloud;
+  for (int i = 0; i < 1000; i++) {
+    Particle p;
+    p.x = i * 0.5;
+    p.y = -i * 2.0;
+    p.id = i;
+    p.kind = static_cast<char>('a' + i % 26);
+    cloud.particles.push_back(p);
+  }
+
+  // No padding on the wire: each field is its own packed column
+  auto const n = cloud.particles.size();
+  auto ser = serializeType(cloud);
+  EXPECT_EQ(
+    std::get<1>(ser),
+    sizeof(SerialSizeType) + n * (2 * sizeof(double) + sizeof(int) + 1)
+  );
+
+  // The id column follows the x and y columns
+  auto const buf = std::get<0>(ser)->getBuffer();
+  int id = 0;
+  std::memcpy(
+    &id, buf + sizeof(SerialSizeType) + 2 * n * sizeof(double) + 5 * sizeof(int),
+    sizeof(int)
+  );
+  EXPECT_EQ(id, 5);
+
+  auto out = deserializeType<Cloud>(buf, std::get<1>(ser));
+  EXPECT_EQ(out->particles, cloud.particles);
+  delete out;
+}
+
+struct CountingSizer : Sizer {
+  void contiguousBytes(void* ptr, SerialSizeType size, SerialSizeType num) {
+    calls++;
+    Sizer::contiguousBytes(ptr, size, num);
+  }
+
+  int calls = 0;
+};
+
+TEST_F(TestColumnar, test_coalesced_fields) {
+  using ::userTest::Sample;
+  using ::userTest::SampleManual;
+
+  SampleManual manual;
+  manual.a = 1; manual.b = 2; manual.c = 3; manual.d = 4.5; manual.e = 'e';
+  manual.f = 6.5; manual.label = "seven"; manual.g = 8.f; manual.h = 9.f;
+  Sample& sample = manual;
+
+  // Identical wire format to the member-by-member version
+  auto ser_fields = serializeType(sample);
+  auto ser_manual = serializeType(manual);
+  ASSERT_EQ(std::get<1>(ser_fields), std::get<1>(ser_manual));
+  EXPECT_EQ(
+    0, std::memcmp(
+      std::get<0>(ser_fields)->getBuffer(), std::get<0>(ser_manual)->getBuffer(),
+      std::get<1>(ser_fields)
+    )
+  );
+
+  // Runs: {a,b,c} {d,e} {f} label(size, chars) {g,h}, versus 10 per member
+  CountingSizer counter;
+  counter | sample;
+  EXPECT_EQ(counter.calls, 6);
+
+  auto out = deserializeType<Sample>(
+    std::get<0>(ser_fields)->getBuffer(), std::get<1>(ser_fields)
+  );
+  EXPECT_EQ(out->a, 1);
+  EXPECT_EQ(out->c, 3);
+  EXPECT_EQ(out->e, 'e');
+  EXPECT_EQ(out->f, 6.5);
+  EXPECT_EQ(out->label, "seven");
+  EXPECT_EQ(out->h, 9.f);
+  delete out;
+}
+
+TEST_F(TestColumnar, test_wide_field_list) {
+  using ::userTest::Wide;
+
+  EXPECT_EQ(Fields<Wide>::num_fields, 21u);
+
+  Wide wide;
+  wide.f0 = 1; wide.f7 = 8; wide.f15 = 16; wide.name = "wide";
+  wide.f16 = 17.5; wide.f19 = 20.5;
+
+  // Two coalesced runs around the string: 16 ints, then 4 doubles
+  auto ser = serializeType(wide);
+  EXPECT_EQ(
+    std::get<1>(ser),
+    16 * sizeof(int) + sizeType(wide.name) + 4 * sizeof(double)
+  );
+
+  auto out = deserializeType<Wide>(
+    std::get<0>(ser)->getBuffer(), std::get<1>(ser)
+  );
+  EXPECT_EQ(out->f0, 1);
+  EXPECT_EQ(out->f7, 8);
+  EXPECT_EQ(out->f15, 16);
+  EXPECT_EQ(out->name, "wide");
+  EXPECT_EQ(out->f16, 17.5);
+  EXPECT_EQ(out->f19, 20.5);
+  delete out;
+}
+
+}}} // end namespace serdes::tests::unit
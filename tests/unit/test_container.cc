@@ -48,6 +48,16 @@
 
 #include "serdes_headers.h"
 
+#include <algorithm>
+#include <cstring>
+#include <deque>
+#include <list>
+#include <map>
+#include <string>
+#include <tuple>
+#include <unordered_map>
+#include <vector>
+
 namespace serdes { namespace tests { namespace unit {
 
 template <typename ContainerT>
@@ -267,4 +277,170 @@ INSTANTIATE_TYPED_TEST_CASE_P(TestMultiDouble_int64_t, TestMultiContainerUnorder
 INSTANTIATE_TYPED_TEST_CASE_P(TestMultiDouble_int16_t, TestMultiContainerUnordered, ContainerMultiTypesUnorderedDouble<int16_t>);
 INSTANTIATE_TYPED_TEST_CASE_P(TestMultiDouble_float, TestMultiContainerUnordered, ContainerMultiTypesUnorderedDouble<float>);
 
+struct TestMapReconstruct : TestHarness { };
+
+TEST_F(TestMapReconstruct, test_map_reconstruct_strings) {
+  using namespace serdes;
+
+  std::map<std::string, std::string> map;
+  std::unordered_map<std::string, std::string> umap;
+  for (int i = 0; i < 1000; i++) {
+    map[std::to_string(i)] = std::string(i % 37, 'x');
+    umap[std::to_string(i)] = std::string(i % 41, 'y');
+  }
+
+  // Equal keys must come back in their original relative order
+  std::multimap<int, std::string> mmap{{1, "c"}, {0, "a"}, {1, "b"}, {1, "a"}};
+
+  auto ser_map = serializeType(map);
+  auto out_map = deserializeType<decltype(map)>(
+    std::get<0>(ser_map)->getBuffer(), std::get<1>(ser_map)
+  );
+  EXPECT_EQ(*out_map, map);
+  delete out_map;
+
+  auto ser_umap = serializeType(umap);
+  auto out_umap = deserializeType<decltype(umap)>(
+    std::get<0>(ser_umap)->getBuffer(), std::get<1>(ser_umap)
+  );
+  EXPECT_EQ(*out_umap, umap);
+  delete out_umap;
+
+  auto ser_mmap = serializeType(mmap);
+  auto out_mmap = deserializeType<decltype(mmap)>(
+    std::get<0>(ser_mmap)->getBuffer(), std::get<1>(ser_mmap)
+  );
+  EXPECT_TRUE(
+    std::equal(mmap.begin(), mmap.end(), out_mmap->begin(), out_mmap->end())
+  );
+  delete out_mmap;
+}
+
+struct TestUninitUnpack : TestHarness {
+  struct Record {
+    char tag = 0;
+    std::vector<double> values;
+    std::string name;
+    std::deque<std::string> notes;
+    std::list<std::vector<int>> chunks;
+
+    template <typename Serializer>
+    void serialize(Serializer& s) {
+      s | tag | values | name | notes | chunks;
+    }
+  };
+};
+
+TEST_F(TestUninitUnpack, test_uninit_unpack_misaligned) {
+  using namespace serdes;
+
+  // The leading char leaves the vector payload misaligned in the buffer
+  Record rec;
+  rec.tag = 'r';
+  rec.values = {1.5, -2.25, 3.0, 1e300};
+  rec.name = "checkpoint";
+  rec.notes = {"a", "", std::string(100, 'n')};
+  rec.chunks = {{1, 2, 3}, {}, {4}};
+
+  auto ser = serializeType(rec);
+  auto out = deserializeType<Record>(
+    std::get<0>(ser)->getBuffer(), std::get<1>(ser)
+  );
+
+  EXPECT_EQ(out->tag, rec.tag);
+  EXPECT_EQ(out->values, rec.values);
+  EXPECT_EQ(out->name, rec.name);
+  EXPECT_EQ(out->notes, rec.notes);
+  EXPECT_EQ(out->chunks, rec.chunks);
+  delete out;
+}
+
+struct TestBulkOrdered : TestHarness { };
+
+TEST_F(TestBulkOrdered, test_bulk_deque_list) {
+  using namespace serdes;
+
+  // Large enough to span many deque blocks
+  std::deque<double> dq;
+  std::list<int> lst;
+  std::vector<double> vec;
+  for (int i = 0; i < 10000; i++) {
+    dq.push_back(i * 0.5);
+    vec.push_back(i * 0.5);
+    lst.push_back(-i);
+  }
+  dq.pop_front();
+  vec.erase(vec.begin());
+
+  // Bulk packing keeps the element-wise wire format
+  auto ser_dq = serializeType(dq);
+  auto ser_vec = serializeType(vec);
+  ASSERT_EQ(std::get<1>(ser_dq), std::get<1>(ser_vec));
+  EXPECT_EQ(
+    0, std::memcmp(
+      std::get<0>(ser_dq)->getBuffer(), std::get<0>(ser_vec)->getBuffer(),
+      std::get<1>(ser_dq)
+    )
+  );
+
+  auto out_dq = deserializeType<std::deque<double>>(
+    std::get<0>(ser_dq)->getBuffer(), std::get<1>(ser_dq)
+  );
+  EXPECT_EQ(*out_dq, dq);
+  delete out_dq;
+
+  // Misaligned payload in a tuple after a char
+  auto tup = std::make_tuple('x', lst, dq);
+  auto ser_tup = serializeType(tup);
+  auto out_tup = deserializeType<decltype(tup)>(
+    std::get<0>(ser_tup)->getBuffer(), std::get<1>(ser_tup)
+  );
+  EXPECT_EQ(*out_tup, tup);
+  delete out_tup;
+}
+
+struct TestFlattened : TestHarness {
+  struct Mesh {
+    int id = 0;
+    std::vector<std::vector<double>> rows;
+    std::vector<std::vector<std::string>> labels;
+
+    template <typename Serializer>
+    void serialize(Serializer& s) {
+      s | id;
+      serializeFlattened(s, rows);
+      serializeFlattened(s, labels);
+    }
+  };
+};
+
+TEST_F(TestFlattened, test_flattened_nested_vector) {
+  using namespace serdes;
+
+  Mesh mesh;
+  mesh.id = 7;
+  for (int i = 0; i < 1000; i++) {
+    mesh.rows.emplace_back(i % 5, i * 1.25);
+  }
+  mesh.rows.emplace_back();
+  mesh.labels = {{"a", "bc"}, {}, {"def"}};
+
+  SerialSizeType const expected_size = sizeof(int) +
+    sizeof(SerialSizeType) * (1 + mesh.rows.size() + 1) +
+    sizeof(double) * 2000 +
+    sizeType(mesh.labels) - sizeof(SerialSizeType) * mesh.labels.size() +
+    sizeof(SerialSizeType) * (mesh.labels.size() + 1);
+
+  auto ser = serializeType(mesh);
+  EXPECT_EQ(std::get<1>(ser), expected_size);
+
+  auto out = deserializeType<Mesh>(
+    std::get<0>(ser)->getBuffer(), std::get<1>(ser)
+  );
+  EXPECT_EQ(out->id, mesh.id);
+  EXPECT_EQ(out->rows, mesh.rows);
+  EXPECT_EQ(out->labels, mesh.labels);
+  delete out;
+}
+
 }}} // end namespace serdes::tests::unit
@@ -0,0 +1,230 @@
+/*
+//@HEADER
+// *****************************************************************************
+//
+//                             test_direct_file.cc
+//                           DARMA Toolkit v. 1.0.0
+//                 DARMA/checkpoint => Serialization Library
+//
+// Copyright 2019 National Technology & Engineering Solutions of Sandia, LLC
+// (NTESS). Under the terms of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the following disclaimer.
+//
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// * Neither the name of the copyright holder nor the names of its
+//   contributors may be used to endorse or promote products derived from this
+//   software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact darma@sandia.gov
+//
+// *****************************************************************************
+//@HEADER
+*/
+
+#include <gtest/gtest.h>
+
+#include "test_harness.h"
+
+#include "serdes_headers.h"
+
+#include <string>
+#include <vector>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+
+#include <unistd.h>
+
+namespace serdes { namespace tests { namespace unit {
+
+struct TestDirectFile : TestHarness {
+  virtual void SetUp() {
+    TestHarness::SetUp();
+    char dir_template[] = "/tmp/serdes-direct-XXXXXX";
+    dir_ = mkdtemp(dir_template);
+    path_ = dir_ + "/checkpoint.bin";
+  }
+
+  virtual void TearDown() {
+    std::remove(path_.c_str());
+    rmdir(dir_.c_str());
+    TestHarness::TearDown();
+  }
+
+  std::string dir_;
+  std::string path_;
+};
+
+struct FileTestObject {
+  int a = 0;
+  std::vector<double> vec;
+  std::string str;
+
+  template <typename Serializer>
+  void serialize(Serializer& s) {
+    s | a | vec | str;
+  }
+
+  void init() {
+    a = 29;
+    for (int i = 0; i < 1000; i++) {
+      vec.push_back(i * 1.5);
+    }
+    str = "checkpoint-file";
+  }
+
+  void check() {
+    EXPECT_EQ(a, 29);
+    EXPECT_EQ(vec.size(), 1000UL);
+    for (int i = 0; i < 1000; i++) {
+      EXPECT_EQ(vec[i], i * 1.5);
+    }
+    EXPECT_EQ(str, "checkpoint-file");
+  }
+};
+
+static SerialSizeType fileSize(std::string const& path) {
+  std::ifstream in(path, std::ios::binary | std::ios::ate);
+  return static_cast<SerialSizeType>(in.tellg());
+}
+
+TEST_F(TestDirectFile, test_direct_file_roundtrip) {
+  FileTestObject obj;
+  obj.init();
+
+  EXPECT_TRUE(serializeToFile(obj, path_));
+
+  // The file is a whole number of blocks: header, payload, and tail padding
+  auto const payload = sizeType(obj);
+  auto const header = FileHeader::headerSize(default_block_size);
+  auto const on_disk = fileSize(path_);
+  EXPECT_EQ(on_disk % default_block_size, 0UL);
+  EXPECT_EQ(on_disk, header + roundUpToBlock(payload, default_block_size));
+
+  auto out = deserializeFromFile<FileTestObject>(path_);
+  ASSERT_NE(out, nullptr);
+  out->check();
+  delete out;
+}
+
+TEST_F(TestDirectFile, test_direct_file_pool_reuse) {
+  AlignedBufferPool pool;
+  FileTestObject obj;
+  obj.init();
+
+  for (int i = 0; i < 3; i++) {
+    EXPECT_TRUE(serializeToFile(obj, path_, &pool));
+    auto out = deserializeFromFile<FileTestObject>(path_, nullptr, &pool);
+    ASSERT_NE(out, nullptr);
+    out->check();
+    delete out;
+  }
+
+  auto buf = pool.acquire(default_block_size);
+  EXPECT_EQ(reinterpret_cast<uintptr_t>(buf->getBlock()) % default_block_size, 0UL);
+  EXPECT_EQ(buf->getCapacity() % default_block_size, 0UL);
+}
+
+TEST_F(TestDirectFile, test_direct_file_small_block) {
+  // A small payload with a 512-byte block gives a file shorter than the
+  // default block, so read-back must not assume a full first block
+  int obj = 41;
+  SerialSizeType const block = 512;
+  EXPECT_TRUE(serializeToFile(obj, path_, nullptr, block));
+  EXPECT_EQ(fileSize(path_), 2 * block);
+
+  auto out = deserializeFromFile<int>(path_);
+  ASSERT_NE(out, nullptr);
+  EXPECT_EQ(*out, 41);
+  delete out;
+}
+
+TEST_F(TestDirectFile, test_direct_file_o_direct) {
+  // Some filesystems (e.g. tmpfs) reject O_DIRECT and DirectFile silently
+  // falls back to buffered I/O; only this test requires the real O_DIRECT path
+  {
+    DirectFile probe(path_, eFileMode::Write);
+    if (not probe.isDirect()) {
+      GTEST_SKIP() << "O_DIRECT is not supported for " << dir_;
+    }
+  }
+
+  FileTestObject obj;
+  obj.init();
+  EXPECT_TRUE(serializeToFile(obj, path_));
+
+  auto image = readFileImage(path_, nullptr);
+  ASSERT_NE(image, nullptr);
+  auto const header = FileHeader::readFrom(image->getBlock());
+  EXPECT_NE(header.flags & FileHeader::eFlags::DirectIO, 0U);
+
+  auto out = deserializeFromFile<FileTestObject>(path_);
+  ASSERT_NE(out, nullptr);
+  out->check();
+  delete out;
+}
+
+TEST_F(TestDirectFile, test_direct_file_bad_header) {
+  {
+    std::ofstream out(path_, std::ios::binary);
+    std::vector<char> junk(2 * default_block_size, 'x');
+    out.write(junk.data(), junk.size());
+  }
+  auto out = deserializeFromFile<FileTestObject>(path_);
+  EXPECT_EQ(out, nullptr);
+}
+
+TEST_F(TestDirectFile, test_direct_file_bad_header_fields) {
+  // Headers with the right magic but sizes a reader must not trust
+  auto const make = [](uint64_t block, uint64_t header_size, uint64_t payload) {
+    FileHeader header(0, default_block_size);
+    header.block_size = block;
+    header.header_size = header_size;
+    header.payload_size = payload;
+    return header;
+  };
+  auto const good = FileHeader::headerSize(default_block_size);
+  std::vector<FileHeader> bad = {
+    make(default_block_size, 0, 0),
+    make(default_block_size, 1UL << 40, 0),
+    make(24, FileHeader::headerSize(24), 0),
+    make(1, FileHeader::headerSize(1), 0),
+    make(default_block_size, good, ~uint64_t{0} - default_block_size + 1)
+  };
+
+  for (auto&& header : bad) {
+    EXPECT_FALSE(header.valid());
+    {
+      std::vector<SerialByteType> block(2 * default_block_size, 0);
+      std::memcpy(block.data(), &header, sizeof(FileHeader));
+      std::ofstream out(path_, std::ios::binary | std::ios::trunc);
+      out.write(reinterpret_cast<char const*>(block.data()), block.size());
+    }
+    EXPECT_EQ(readFileImage(path_, nullptr), nullptr);
+    EXPECT_EQ(deserializeFromFile<FileTestObject>(path_), nullptr);
+  }
+}
+
+}}} // end namespace serdes::tests::unit
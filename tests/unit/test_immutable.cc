@@ -0,0 +1,193 @@
+/*
+//@HEADER
+// *****************************************************************************
+//
+//                              test_immutable.cc
+//                           DARMA Toolkit v. 1.0.0
+//                 DARMA/checkpoint => Serialization Library
+//
+// Copyright 2019 National Technology & Engineering Solutions of Sandia, LLC
+// (NTESS). Under the terms of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the following disclaimer.
+//
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// * Neither the name of the copyright holder nor the names of its
+//   contributors may be used to endorse or promote products derived from this
+//   software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact darma@sandia.gov
+//
+// *****************************************************************************
+//@HEADER
+*/
+
+#include <gtest/gtest.h>
+
+#include "test_harness.h"
+
+#include "serdes_headers.h"
+
+#include <cstring>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace serdes { namespace tests { namespace unit {
+
+struct TestImmutable : TestHarness {
+  using TableType = std::map<std::string, std::vector<double>>;
+
+  struct State {
+    int step = 0;
+    Immutable<TableType> table;
+
+    template <typename Serializer>
+    void serialize(Serializer& s) {
+      s | step | table;
+    }
+  };
+
+  struct PlainState {
+    int step = 0;
+    TableType table;
+
+    template <typename Serializer>
+    void serialize(Serializer& s) {
+      s | step | table;
+    }
+  };
+
+  struct CountingSizer : Sizer {
+    void contiguousBytes(void* ptr, SerialSizeType size, SerialSizeType num) {
+      calls++;
+      Sizer::contiguousBytes(ptr, size, num);
+    }
+
+    int calls = 0;
+  };
+
+  // Interned strings on both sides of a cached sub-object
+  struct Tagged {
+    std::string before;
+    Immutable<std::vector<std::string>> names;
+    std::string after;
+
+    template <typename Serializer>
+    void serialize(Serializer& s) {
+      serializeInterned(s, before);
+      s | names;
+      serializeInterned(s, after);
+    }
+  };
+
+  static TableType makeTable() {
+    TableType table;
+    for (int i = 0; i < 50; i++) {
+      table["key" + std::to_string(i)] = std::vector<double>(i, i * 0.5);
+    }
+    return table;
+  }
+};
+
+TEST_F(TestImmutable, test_immutable_cache) {
+  State state;
+  state.step = 3;
+  state.table = Immutable<TableType>(makeTable());
+  EXPECT_FALSE(state.table.isCached());
+
+  PlainState plain;
+  plain.step = 3;
+  plain.table = makeTable();
+
+  // Same bytes as the unwrapped object
+  auto ser = serializeType(state);
+  auto ser_plain = serializeType(plain);
+  ASSERT_EQ(std::get<1>(ser), std::get<1>(ser_plain));
+  EXPECT_EQ(
+    0, std::memcmp(
+      std::get<0>(ser)->getBuffer(), std::get<0>(ser_plain)->getBuffer(),
+      std::get<1>(ser)
+    )
+  );
+  EXPECT_TRUE(state.table.isCached());
+  EXPECT_EQ(state.table.getCachedSize(), sizeType(plain.table));
+
+  // Once cached the table is sized with a single call
+  CountingSizer counter;
+  counter | state.table;
+  EXPECT_EQ(counter.calls, 1);
+
+  // Unpacking keeps the received bytes as the cache
+  auto out = deserializeType<State>(std::get<0>(ser)->getBuffer(), std::get<1>(ser));
+  EXPECT_EQ(out->step, 3);
+  EXPECT_EQ(*out->table, plain.table);
+  EXPECT_TRUE(out->table.isCached());
+  delete out;
+
+  // Mutation drops the cache and the next pack picks up the change
+  state.table.mutate()["extra"] = {1.0};
+  EXPECT_FALSE(state.table.isCached());
+  plain.table["extra"] = {1.0};
+  EXPECT_EQ(sizeType(state), sizeType(plain));
+}
+
+TEST_F(TestImmutable, test_immutable_compact) {
+  Immutable<std::vector<int>> ints(std::vector<int>{1, 2, 3});
+
+  // Cached in fixed mode first; a compact pack must not reuse those bytes
+  auto ser_fixed = serializeType(ints);
+  EXPECT_TRUE(ints.isCached());
+  auto ser = serializeTypeWithMode(ints, eWireMode::Compact);
+  EXPECT_LT(std::get<1>(ser), std::get<1>(ser_fixed));
+
+  auto out = deserializeTypeWithMode<Immutable<std::vector<int>>>(
+    std::get<0>(ser)->getBuffer(), std::get<1>(ser)
+  );
+  EXPECT_EQ(out->get(), (std::vector<int>{1, 2, 3}));
+  delete out;
+
+  auto out_fixed = deserializeType<Immutable<std::vector<int>>>(
+    std::get<0>(ser_fixed)->getBuffer(), std::get<1>(ser_fixed)
+  );
+  EXPECT_EQ(out_fixed->get(), (std::vector<int>{1, 2, 3}));
+  delete out_fixed;
+
+  // The cache never refers to the message's string table
+  Tagged tagged;
+  tagged.before = "shared";
+  tagged.names = Immutable<std::vector<std::string>>({"shared", "other"});
+  tagged.after = "other";
+  for (int i = 0; i < 2; i++) {
+    auto ser_tagged = serializeTypeWithMode(tagged, eWireMode::Compact);
+    auto out_tagged = deserializeTypeWithMode<Tagged>(
+      std::get<0>(ser_tagged)->getBuffer(), std::get<1>(ser_tagged)
+    );
+    EXPECT_EQ(out_tagged->before, "shared");
+    EXPECT_EQ(*out_tagged->names, tagged.names.get());
+    EXPECT_EQ(out_tagged->after, "other");
+    delete out_tagged;
+  }
+}
+
+}}} // end namespace serdes::tests::unit
@@ -46,6 +46,8 @@
 #include "test_commons.h"
 #include "test_kokkos_1d_commons.h"
 
+#include <vector>
+
 template <typename ParamT> struct KokkosViewTest1D : KokkosViewTest<ParamT> { };
 
 TYPED_TEST_CASE_P(KokkosViewTest1D);
@@ -123,6 +125,103 @@ INSTANTIATE_TYPED_TEST_CASE_P(
   test_dynamic_view_1, KokkosDynamicViewTest, DynamicTestTypes
 );
 
+struct KokkosDynamicViewChunkTest : TestHarness { };
+
+// Data moves one chunk at a time: cover the chunk boundaries and a partial
+// last chunk
+TEST_F(KokkosDynamicViewChunkTest, test_dynamic_1d_partial_chunk) {
+  using namespace serialization::interface;
+  using ViewType = Kokkos::Experimental::DynamicView<double*>;
+
+  static constexpr unsigned const min_chunk = 8;
+  static constexpr unsigned const max_extent = 1024;
+
+  ViewType in_view("my-dynamic-view-chunks", min_chunk, max_extent);
+  auto const chunk = in_view.chunk_size();
+  auto const n = 3 * chunk + chunk / 2 + 1;
+  in_view.resize_serial(n);
+  EXPECT_NE(n % chunk, 0UL);
+  for (auto i = 0UL; i < n; i++) {
+    in_view(i) = 0.5 * i + 1.0;
+  }
+
+  auto ret = serialize<ViewType>(in_view);
+  auto out_view = deserialize<ViewType>(ret->getBuffer(), ret->getSize());
+  auto const& out_view_ref = *out_view;
+  EXPECT_EQ(out_view_ref.chunk_size(), chunk);
+  ASSERT_EQ(out_view_ref.size(), n);
+  for (auto i = 0UL; i < n; i++) {
+    EXPECT_EQ(in_view(i), out_view_ref(i));
+  }
+}
+
+struct KokkosViewCompactTest : TestHarness { };
+
+TEST_F(KokkosViewCompactTest, test_1d_compact_headers) {
+  using ViewType = Kokkos::View<double*>;
+  static constexpr std::size_t const num_views = 100;
+
+  std::vector<ViewType> in_views;
+  for (auto v = 0UL; v < num_views; v++) {
+    in_views.emplace_back("test-1D-compact-field", 3);
+    init1d(in_views.back());
+  }
+
+  auto fixed = serdes::serializeTypeWithMode(
+    in_views, serdes::eWireMode::Fixed
+  );
+  auto compact = serdes::serializeTypeWithMode(
+    in_views, serdes::eWireMode::Compact
+  );
+  EXPECT_LT(std::get<1>(compact) * 2, std::get<1>(fixed));
+
+  auto out_views = serdes::deserializeTypeWithMode<std::vector<ViewType>>(
+    std::get<0>(compact)->getBuffer(), std::get<1>(compact)
+  );
+  ASSERT_EQ(in_views.size(), out_views->size());
+  for (auto v = 0UL; v < num_views; v++) {
+#if !CHECKPOINT_KOKKOS_COMPACT_OMIT_LABEL
+    compare1d(in_views[v], (*out_views)[v]);
+#else
+    EXPECT_EQ((*out_views)[v].label(), std::string{});
+#endif
+  }
+  delete out_views;
+}
+
+struct KokkosViewReuseTest : TestHarness { };
+
+TEST_F(KokkosViewReuseTest, test_1d_unpack_in_place_reuses_allocation) {
+  using namespace serialization::interface;
+
+  using ViewType = Kokkos::View<double*>;
+  static constexpr std::size_t const N = 64;
+
+  ViewType in_view("test-1D-reuse", N);
+  init1d(in_view);
+  auto ret = serialize<ViewType>(in_view);
+
+  // Same label and extent: the existing allocation is overwritten in place
+  ViewType out_view("test-1D-reuse", N);
+  auto const data = out_view.data();
+  deserializeInPlace<ViewType>(ret->getBuffer(), ret->getSize(), &out_view);
+  EXPECT_EQ(data, out_view.data());
+  compare1d(in_view, out_view);
+
+  // A different extent needs a new allocation
+  ViewType other_view("test-1D-reuse", N / 2);
+  deserializeInPlace<ViewType>(ret->getBuffer(), ret->getSize(), &other_view);
+  EXPECT_EQ(N, other_view.extent(0));
+  compare1d(in_view, other_view);
+
+  // A view shared with another handle is never overwritten
+  ViewType shared_view("test-1D-reuse", N);
+  ViewType alias = shared_view;
+  deserializeInPlace<ViewType>(ret->getBuffer(), ret->getSize(), &shared_view);
+  EXPECT_NE(alias.data(), shared_view.data());
+  compare1d(in_view, shared_view);
+}
+
 
 
 #endif
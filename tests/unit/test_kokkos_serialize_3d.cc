@@ -91,4 +91,36 @@ INSTANTIATE_TYPED_TEST_CASE_P(test_3d_S_C, KokkosViewTest3D, Test3DConstTypesStr
 
 #endif
 
+struct KokkosViewTest3DLarge : TestHarness { };
+
+// These views are above CHECKPOINT_KOKKOS_PARALLEL_PACK_MIN_BYTES, so with
+// parallel packing enabled and a multi-threaded host backend (e.g., OpenMP)
+// they are packed and unpacked with parallel_for
+TEST_F(KokkosViewTest3DLarge, test_3d_large_contiguous) {
+  using ViewType = Kokkos::View<double***, Kokkos::LayoutRight>;
+  static constexpr size_t const N = 64;
+  static constexpr size_t const M = 64;
+  static constexpr size_t const Q = 48;
+
+  ViewType in_view("test-3D-large", N, M, Q);
+  init3d(in_view);
+
+  serializeAny<ViewType>(in_view, &compare3d<ViewType>);
+}
+
+TEST_F(KokkosViewTest3DLarge, test_3d_large_padded) {
+  using ViewType = Kokkos::View<double***, Kokkos::LayoutStride>;
+  static constexpr size_t const N = 64;
+  static constexpr size_t const M = 64;
+  static constexpr size_t const Q = 48;
+
+  ViewType in_view(
+    "test-3D-large-padded", Kokkos::LayoutStride{N,1,M,N+1,Q,(N+1)*(M+2)}
+  );
+  EXPECT_FALSE(in_view.span_is_contiguous());
+  init3d(in_view);
+
+  serializeAny<ViewType>(in_view, &compare3d<ViewType>);
+}
+
 #endif
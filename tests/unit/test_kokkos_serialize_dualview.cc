@@ -0,0 +1,110 @@
+/*
+//@HEADER
+// *****************************************************************************
+//
+//                      test_kokkos_serialize_dualview.cc
+//                           DARMA Toolkit v. 1.0.0
+//                 DARMA/checkpoint => Serialization Library
+//
+// Copyright 2019 National Technology & Engineering Solutions of Sandia, LLC
+// (NTESS). Under the terms of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the following disclaimer.
+//
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// * Neither the name of the copyright holder nor the names of its
+//   contributors may be used to endorse or promote products derived from this
+//   software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact darma@sandia.gov
+//
+// *****************************************************************************
+//@HEADER
+*/
+#if KOKKOS_ENABLED_SERDES
+
+#include "test_harness.h"
+#include "test_commons.h"
+
+#include <Kokkos_DualView.hpp>
+
+struct KokkosDualViewTest : TestHarness { };
+
+// Host-only execution space: both sides of the DualView live in host memory
+using DualViewType =
+  Kokkos::DualView<double*, Kokkos::DefaultHostExecutionSpace>;
+
+static constexpr std::size_t const N = 29;
+
+static void expectRestored(DualViewType const& in, DualViewType const& out) {
+  EXPECT_EQ(in.h_view.label(), out.h_view.label());
+  ASSERT_EQ(in.extent(0), out.extent(0));
+  for (auto i = 0UL; i < N; i++) {
+    EXPECT_EQ(in.h_view(i), out.h_view(i));
+  }
+
+  // Restored into the host side, which is marked modified
+  EXPECT_FALSE(out.need_sync_host());
+  EXPECT_TRUE(out.need_sync_device());
+}
+
+TEST_F(KokkosDualViewTest, test_dualview_host_modified) {
+  using namespace serialization::interface;
+
+  DualViewType in("test-dualview-host", N);
+  for (auto i = 0UL; i < N; i++) {
+    in.h_view(i) = 1.5 * i;
+  }
+  in.modify_host();
+
+  auto ret = serialize<DualViewType>(in);
+
+  // Packing does not sync the DualView
+  EXPECT_TRUE(in.need_sync_device());
+
+  auto out = deserialize<DualViewType>(ret->getBuffer(), ret->getSize());
+  expectRestored(in, *out);
+  delete out;
+}
+
+TEST_F(KokkosDualViewTest, test_dualview_device_modified) {
+  using namespace serialization::interface;
+
+  DualViewType in("test-dualview-device", N);
+  for (auto i = 0UL; i < N; i++) {
+    in.d_view(i) = 2.5 * i;
+  }
+  in.modify_device();
+
+  auto ret = serialize<DualViewType>(in);
+
+  // The device side is serialized without syncing it to the host side
+  EXPECT_TRUE(in.need_sync_host());
+
+  in.sync_host();
+  auto out = deserialize<DualViewType>(ret->getBuffer(), ret->getSize());
+  expectRestored(in, *out);
+  delete out;
+}
+
+#endif
@@ -65,4 +65,65 @@ inline Kokkos::LayoutStride layout4d(lsType d1,lsType d2,lsType d3,lsType d4) {
   return Kokkos::LayoutStride{d1,1,d2,d1,d3,d1*d2,d4,d1*d2*d3};
 }
 
+// Apply fn(n, offset) to every element of a strided view, where n is the
+// element's row-major index and offset its position from data()
+template <typename ViewT, typename FnT>
+static void forEachOffset(ViewT const& v, FnT fn) {
+  for (std::size_t n = 0; n < v.size(); n++) {
+    std::size_t offset = 0;
+    std::size_t rem = n;
+    for (std::size_t d = ViewT::Rank; d > 0; d--) {
+      offset += (rem % v.extent(d - 1)) * v.stride(d - 1);
+      rem /= v.extent(d - 1);
+    }
+    fn(n, offset);
+  }
+}
+
+template <typename ViewT>
+static void serializeStrided(ViewT const& in_view) {
+  using namespace serialization::interface;
+
+  EXPECT_FALSE(in_view.span_is_contiguous());
+  forEachOffset(in_view, [&](std::size_t n, std::size_t offset) {
+    in_view.data()[offset] = static_cast<double>(n);
+  });
+
+  auto ret = serialize<ViewT>(in_view);
+  auto out_view = deserialize<ViewT>(ret->getBuffer(), ret->getSize());
+  auto const& out_view_ref = *out_view;
+
+  EXPECT_EQ(in_view.label(), out_view_ref.label());
+  for (std::size_t d = 0; d < ViewT::Rank; d++) {
+    EXPECT_EQ(in_view.extent(d), out_view_ref.extent(d));
+    EXPECT_EQ(in_view.stride(d), out_view_ref.stride(d));
+  }
+  forEachOffset(in_view, [&](std::size_t, std::size_t offset) {
+    EXPECT_EQ(in_view.data()[offset], out_view_ref.data()[offset]);
+  });
+}
+
+struct KokkosViewTestND : TestHarness { };
+
+// Padded strides in a permuted memory order: dimension 2 is innermost and
+// dimension 3 outermost
+TEST_F(KokkosViewTestND, test_5d_permuted_padded) {
+  using ViewType = Kokkos::View<double*****, Kokkos::LayoutStride>;
+  ViewType in_view(
+    "test-5D-permuted",
+    Kokkos::LayoutStride{3,6, 4,110, 5,1, 2,440, 6,18}
+  );
+  serializeStrided(in_view);
+}
+
+// Every dimension strided, including the innermost one
+TEST_F(KokkosViewTestND, test_8d_strided) {
+  using ViewType = Kokkos::View<double********, Kokkos::LayoutStride>;
+  ViewType in_view(
+    "test-8D-strided",
+    Kokkos::LayoutStride{2,2, 2,4, 2,8, 2,16, 2,32, 2,64, 2,128, 2,256}
+  );
+  serializeStrided(in_view);
+}
+
 #endif
@@ -0,0 +1,190 @@
+/*
+//@HEADER
+// *****************************************************************************
+//
+//                          test_kokkos_slice_plan.cc
+//                           DARMA Toolkit v. 1.0.0
+//                 DARMA/checkpoint => Serialization Library
+//
+// Copyright 2019 National Technology & Engineering Solutions of Sandia, LLC
+// (NTESS). Under the terms of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the following disclaimer.
+//
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// * Neither the name of the copyright holder nor the names of its
+//   contributors may be used to endorse or promote products derived from this
+//   software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact darma@sandia.gov
+//
+// *****************************************************************************
+//@HEADER
+*/
+#if KOKKOS_ENABLED_SERDES
+
+#include "test_harness.h"
+#include "test_commons.h"
+
+#include <vector>
+
+struct KokkosSlicePlanTest : TestHarness { };
+
+using FieldType = Kokkos::View<double***, Kokkos::LayoutRight>;
+
+static constexpr std::size_t const NX = 8;
+static constexpr std::size_t const NY = 9;
+static constexpr std::size_t const NZ = 10;
+
+// The six one-cell-thick faces of a field
+static void addFaces(serdes::ViewSlicePlan& plan, FieldType const& v) {
+  auto const all = Kokkos::ALL;
+  plan.addSlice(v, 0, all, all);
+  plan.addSlice(v, NX - 1, all, all);
+  plan.addSlice(v, all, 0, all);
+  plan.addSlice(v, all, NY - 1, all);
+  plan.addSlice(v, all, all, 0);
+  plan.addSlice(v, all, all, NZ - 1);
+}
+
+static bool onFace(std::size_t i, std::size_t j, std::size_t k) {
+  return i == 0 or i == NX - 1 or j == 0 or j == NY - 1 or
+         k == 0 or k == NZ - 1;
+}
+
+TEST_F(KokkosSlicePlanTest, test_slice_plan_faces_roundtrip) {
+  FieldType in_view("test-slice-in", NX, NY, NZ);
+  FieldType out_view("test-slice-out", NX, NY, NZ);
+  for (auto i = 0UL; i < NX; i++) {
+    for (auto j = 0UL; j < NY; j++) {
+      for (auto k = 0UL; k < NZ; k++) {
+        in_view(i,j,k) = static_cast<double>((i*NY + j)*NZ + k);
+        out_view(i,j,k) = -1.0;
+      }
+    }
+  }
+
+  serdes::ViewSlicePlan in_plan, out_plan;
+  addFaces(in_plan, in_view);
+  addFaces(out_plan, out_view);
+
+  auto const face_elms = 2*(NY*NZ + NX*NZ + NX*NY);
+  EXPECT_EQ(in_plan.getSize(), face_elms * sizeof(double));
+  EXPECT_EQ(in_plan.getSize(), out_plan.getSize());
+
+  std::vector<serdes::SerialByteType> buf(in_plan.getSize());
+  in_plan.pack(buf.data());
+  out_plan.unpack(buf.data());
+
+  for (auto i = 0UL; i < NX; i++) {
+    for (auto j = 0UL; j < NY; j++) {
+      for (auto k = 0UL; k < NZ; k++) {
+        if (onFace(i,j,k)) {
+          EXPECT_EQ(in_view(i,j,k), out_view(i,j,k));
+        } else {
+          EXPECT_EQ(-1.0, out_view(i,j,k));
+        }
+      }
+    }
+  }
+}
+
+TEST_F(KokkosSlicePlanTest, test_slice_plan_contiguous_face_is_one_run) {
+  FieldType view("test-slice-runs", NX, NY, NZ);
+
+  // In LayoutRight an i-face is one contiguous block; a k-face is strided
+  serdes::ViewSlicePlan i_plan, k_plan;
+  i_plan.addSlice(view, 0, Kokkos::ALL, Kokkos::ALL);
+  k_plan.addSlice(view, Kokkos::ALL, Kokkos::ALL, 0);
+
+  EXPECT_EQ(i_plan.getNumRuns(), 1UL);
+  EXPECT_EQ(k_plan.getSize(), NX * NY * sizeof(double));
+}
+
+TEST_F(KokkosSlicePlanTest, test_slice_plan_serialize_multiple_views) {
+  Kokkos::View<int**> a("test-slice-a", 6, 7);
+  Kokkos::View<double*> b("test-slice-b", 5);
+  for (auto i = 0UL; i < 6; i++) {
+    for (auto j = 0UL; j < 7; j++) {
+      a(i,j) = static_cast<int>(i*7 + j);
+    }
+  }
+  for (auto i = 0UL; i < 5; i++) {
+    b(i) = 0.5 * i;
+  }
+
+  serdes::ViewSlicePlan plan;
+  plan.addSlice(a, Kokkos::make_pair(1,3), Kokkos::make_pair(2,6));
+  plan.addSlice(b, Kokkos::make_pair(1,4));
+
+  serdes::Sizer sizer;
+  serdes::serializeSlices(sizer, plan);
+  EXPECT_EQ(sizer.getSize(), 2*4*sizeof(int) + 3*sizeof(double));
+
+  Kokkos::View<int**> a_out("test-slice-a", 6, 7);
+  Kokkos::View<double*> b_out("test-slice-b", 5);
+  serdes::ViewSlicePlan out_plan;
+  out_plan.addSlice(a_out, Kokkos::make_pair(1,3), Kokkos::make_pair(2,6));
+  out_plan.addSlice(b_out, Kokkos::make_pair(1,4));
+
+  std::vector<serdes::SerialByteType> buf(plan.getSize());
+  plan.pack(buf.data());
+  out_plan.unpack(buf.data());
+
+  for (auto i = 1UL; i < 3; i++) {
+    for (auto j = 2UL; j < 6; j++) {
+      EXPECT_EQ(a(i,j), a_out(i,j));
+    }
+  }
+  for (auto i = 1UL; i < 4; i++) {
+    EXPECT_EQ(b(i), b_out(i));
+  }
+}
+
+TEST_F(KokkosSlicePlanTest, test_slice_plan_serialize_without_cursor) {
+  FieldType view("test-slice-nocursor", NX, NY, NZ);
+  for (auto i = 0UL; i < NX; i++) {
+    for (auto j = 0UL; j < NY; j++) {
+      for (auto k = 0UL; k < NZ; k++) {
+        view(i,j,k) = static_cast<double>((i*NY + j)*NZ + k);
+      }
+    }
+  }
+
+  serdes::ViewSlicePlan plan;
+  addFaces(plan, view);
+  std::vector<serdes::SerialByteType> expected(plan.getSize());
+  plan.pack(expected.data());
+
+  // PlanRecorder has no memory cursor, so every run goes to contiguousBytes
+  serdes::PackPlan recorded;
+  serdes::PlanRecorder recorder(recorded, nullptr, 0);
+  serdes::serializeSlices(recorder, plan);
+  ASSERT_EQ(recorded.getSize(), plan.getSize());
+
+  std::vector<serdes::SerialByteType> buf(recorded.getSize());
+  recorded.replay(buf.data());
+  EXPECT_EQ(buf, expected);
+}
+
+#endif
@@ -0,0 +1,130 @@
+/*
+//@HEADER
+// *****************************************************************************
+//
+//                              test_shm_store.cc
+//                           DARMA Toolkit v. 1.0.0
+//                 DARMA/checkpoint => Serialization Library
+//
+// Copyright 2019 National Technology & Engineering Solutions of Sandia, LLC
+// (NTESS). Under the terms of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the following disclaimer.
+//
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// * Neither the name of the copyright holder nor the names of its
+//   contributors may be used to endorse or promote products derived from this
+//   software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact darma@sandia.gov
+//
+// *****************************************************************************
+//@HEADER
+*/
+
+#include <gtest/gtest.h>
+
+#include "test_harness.h"
+
+#include "serdes_headers.h"
+
+#include <string>
+#include <vector>
+
+#include <unistd.h>
+
+namespace serdes { namespace tests { namespace unit {
+
+struct TestSharedMemoryStore : TestHarness {
+  virtual void SetUp() {
+    name_ = "/serdes-test-" + std::to_string(::getpid());
+    SharedMemoryStore::unlink(name_);
+  }
+
+  virtual void TearDown() {
+    SharedMemoryStore::unlink(name_);
+  }
+
+  std::string name_;
+};
+
+TEST_F(TestSharedMemoryStore, test_shm_store_versions) {
+  using VecType = std::vector<int>;
+
+  SharedMemoryStore store(name_, 2, 4096);
+  ASSERT_TRUE(store.isOpen());
+  EXPECT_EQ(store.latestVersion(), SharedMemoryStore::no_version);
+  EXPECT_EQ(store.load<VecType>(), nullptr);
+
+  VecType v1{1, 2, 3}, v2{4, 5, 6, 7}, v3{8};
+  auto const id1 = store.store(v1);
+  auto const id2 = store.store(v2);
+  auto const id3 = store.store(v3);
+  EXPECT_EQ(id1 + 1, id2);
+  EXPECT_EQ(id2 + 1, id3);
+  EXPECT_EQ(store.latestVersion(), id3);
+
+  // Only the last two versions are retained
+  EXPECT_FALSE(store.hasVersion(id1));
+  EXPECT_EQ(store.load<VecType>(nullptr, id1), nullptr);
+
+  auto out = store.load<VecType>(nullptr, id2);
+  ASSERT_NE(out, nullptr);
+  EXPECT_EQ(*out, v2);
+  delete out;
+
+  // Larger than a slot: rejected, latest version untouched
+  VecType big(4096, 1);
+  EXPECT_EQ(store.store(big), SharedMemoryStore::no_version);
+  EXPECT_EQ(store.latestVersion(), id3);
+}
+
+TEST_F(TestSharedMemoryStore, test_shm_store_restart) {
+  using VecType = std::vector<double>;
+
+  VecType state(100, 3.5);
+  {
+    SharedMemoryStore store(name_, 3, 8192);
+    ASSERT_TRUE(store.isOpen());
+    store.store(state);
+  }
+
+  // A new process attaching by name finds the committed checkpoint
+  SharedMemoryStore restart(name_);
+  ASSERT_TRUE(restart.isOpen());
+  EXPECT_EQ(restart.getNumVersions(), 3u);
+  EXPECT_EQ(restart.getSlotCapacity(), 8192u);
+
+  auto out = restart.load<VecType>();
+  ASSERT_NE(out, nullptr);
+  EXPECT_EQ(*out, state);
+  delete out;
+
+  // Re-creating with the same geometry keeps existing versions
+  SharedMemoryStore reopen(name_, 3, 8192);
+  EXPECT_EQ(reopen.latestVersion(), restart.latestVersion());
+
+  EXPECT_FALSE(SharedMemoryStore(name_ + "-missing").isOpen());
+}
+
+}}} // end namespace serdes::tests::unit
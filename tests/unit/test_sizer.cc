@@ -48,6 +48,8 @@
 
 #include "serdes_headers.h"
 
+#include <vector>
+
 namespace serdes { namespace tests { namespace unit {
 
 struct TestSizer : TestHarness { };
@@ -93,6 +95,27 @@ void serialize(Serializer& s, Test4 t) {
   s | t.c;
 }
 
+struct Test5 {
+  std::vector<std::vector<int>> rows;
+  SerialSizeType num_elms = 0;
+  mutable int size_queries = 0;
+
+  void addRow(std::vector<int> row) {
+    num_elms += row.size();
+    rows.push_back(std::move(row));
+  }
+
+  SerialSizeType serializedSize() const {
+    size_queries++;
+    return sizeof(SerialSizeType) * (1 + rows.size()) + sizeof(int) * num_elms;
+  }
+
+  template <typename Serializer>
+  void serialize(Serializer& s) {
+    s | rows;
+  }
+};
+
 TEST_F(TestSizer, test_sizer_1) {
   using namespace serdes;
 
@@ -125,4 +148,48 @@ TEST_F(TestSizer, test_sizer_4) {
   EXPECT_EQ(size, sizeof(int)*3);
 }
 
+TEST_F(TestSizer, test_sizer_serialized_size_hook) {
+  using namespace serdes;
+
+  Test5 t;
+  t.addRow({1, 2, 3});
+  t.addRow({});
+  t.addRow({4});
+
+  // The sizer asks the object instead of walking it
+  auto const& size = Dispatch<Test5>::sizeType(t);
+  EXPECT_EQ(t.size_queries, 1);
+  EXPECT_EQ(size, sizeof(SerialSizeType) * 4 + sizeof(int) * 4);
+
+  auto ser = serializeType(t);
+  EXPECT_EQ(std::get<1>(ser), size);
+
+  auto out = deserializeType<Test5>(std::get<0>(ser)->getBuffer(), size);
+  EXPECT_EQ(out->rows, t.rows);
+  delete out;
+}
+
+TEST_F(TestSizer, test_sizer_serialized_size_hook_compact) {
+  using namespace serdes;
+
+  Test5 t;
+  t.addRow({1, 2, 3});
+  t.addRow({});
+  t.addRow({4});
+
+  // The hook reports the fixed encoding: compact mode walks the object
+  auto const size = Dispatch<Test5>::sizeType(t, eWireMode::Compact);
+  EXPECT_EQ(t.size_queries, 0);
+  EXPECT_LT(size, t.serializedSize());
+
+  auto ser = serializeTypeWithMode(t, eWireMode::Compact);
+  EXPECT_EQ(std::get<1>(ser), wire_header_size + size);
+
+  auto out = deserializeTypeWithMode<Test5>(
+    std::get<0>(ser)->getBuffer(), std::get<1>(ser)
+  );
+  EXPECT_EQ(out->rows, t.rows);
+  delete out;
+}
+
 }}} // end namespace serdes::tests::unit
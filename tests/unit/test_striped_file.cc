@@ -0,0 +1,149 @@
+/*
+//@HEADER
+// *****************************************************************************
+//
+//                             test_striped_file.cc
+//                           DARMA Toolkit v. 1.0.0
+//                 DARMA/checkpoint => Serialization Library
+//
+// Copyright 2019 National Technology & Engineering Solutions of Sandia, LLC
+// (NTESS). Under the terms of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the following disclaimer.
+//
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// * Neither the name of the copyright holder nor the names of its
+//   contributors may be used to endorse or promote products derived from this
+//   software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact darma@sandia.gov
+//
+// *****************************************************************************
+//@HEADER
+*/
+
+#include <gtest/gtest.h>
+
+#include "test_harness.h"
+
+#include "serdes_headers.h"
+
+#include <string>
+#include <vector>
+#include <cstdio>
+#include <cstdlib>
+
+#include <unistd.h>
+
+namespace serdes { namespace tests { namespace unit {
+
+static constexpr std::size_t const num_stripe_dirs = 3;
+
+struct TestStripedFile : TestHarness {
+  virtual void SetUp() {
+    TestHarness::SetUp();
+    for (std::size_t j = 0; j < num_stripe_dirs; j++) {
+      char dir_template[] = "/tmp/serdes-stripe-XXXXXX";
+      dirs_.push_back(mkdtemp(dir_template));
+    }
+  }
+
+  virtual void TearDown() {
+    for (std::size_t j = 0; j < dirs_.size(); j++) {
+      std::remove(StripeManifest::stripePath(dirs_, name_, j).c_str());
+    }
+    std::remove(StripeManifest::manifestPath(dirs_, name_).c_str());
+    for (auto&& dir : dirs_) {
+      rmdir(dir.c_str());
+    }
+    TestHarness::TearDown();
+  }
+
+  std::vector<std::string> dirs_;
+  std::string name_ = "ckpt";
+};
+
+TEST_F(TestStripedFile, test_striped_roundtrip) {
+  std::vector<int64_t> vec;
+  for (int64_t i = 0; i < 10000; i++) {
+    vec.push_back(i * 7);
+  }
+
+  // Use a single-block stripe unit so every stripe gets many units
+  std::string manifest_path;
+  EXPECT_TRUE(
+    serializeToStripes(vec, dirs_, name_, &manifest_path, default_block_size)
+  );
+
+  StripeManifest manifest;
+  ASSERT_TRUE(StripeManifest::read(manifest_path, manifest));
+  EXPECT_EQ(manifest.stripes.size(), num_stripe_dirs);
+  EXPECT_EQ(manifest.payload_size, sizeType(vec));
+
+  SerialSizeType total = 0;
+  for (std::size_t j = 0; j < num_stripe_dirs; j++) {
+    total += manifest.stripeSize(j);
+  }
+  EXPECT_EQ(total, manifest.paddedSize());
+
+  auto out = deserializeFromStripes<std::vector<int64_t>>(manifest_path);
+  ASSERT_NE(out, nullptr);
+  EXPECT_EQ(*out, vec);
+  delete out;
+}
+
+TEST_F(TestStripedFile, test_striped_missing_stripe) {
+  std::vector<int> vec(5000, 41);
+  std::string manifest_path;
+  EXPECT_TRUE(
+    serializeToStripes(vec, dirs_, name_, &manifest_path, default_block_size)
+  );
+
+  std::remove(StripeManifest::stripePath(dirs_, name_, 1).c_str());
+  auto out = deserializeFromStripes<std::vector<int>>(manifest_path);
+  EXPECT_EQ(out, nullptr);
+}
+
+TEST_F(TestStripedFile, test_striped_failed_rewrite_drops_manifest) {
+  std::vector<int> vec(5000, 41);
+  std::string manifest_path;
+  EXPECT_TRUE(
+    serializeToStripes(vec, dirs_, name_, &manifest_path, default_block_size)
+  );
+
+  // A rewrite that cannot create one of its stripes must not leave the old
+  // manifest pointing at partially overwritten stripes
+  auto bad_dirs = dirs_;
+  bad_dirs.back() += "/missing";
+  std::vector<int> vec2(5000, 42);
+  EXPECT_FALSE(
+    serializeToStripes(vec2, bad_dirs, name_, nullptr, default_block_size)
+  );
+
+  StripeManifest manifest;
+  EXPECT_FALSE(StripeManifest::read(manifest_path, manifest));
+  EXPECT_EQ(deserializeFromStripes<std::vector<int>>(manifest_path), nullptr);
+  EXPECT_NE(access((manifest_path + ".tmp").c_str(), F_OK), 0);
+}
+
+}}} // end namespace serdes::tests::unit
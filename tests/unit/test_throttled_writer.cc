@@ -0,0 +1,148 @@
+/*
+//@HEADER
+// *****************************************************************************
+//
+//                           test_throttled_writer.cc
+//                           DARMA Toolkit v. 1.0.0
+//                 DARMA/checkpoint => Serialization Library
+//
+// Copyright 2019 National Technology & Engineering Solutions of Sandia, LLC
+// (NTESS). Under the terms of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the following disclaimer.
+//
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// * Neither the name of the copyright holder nor the names of its
+//   contributors may be used to endorse or promote products derived from this
+//   software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact darma@sandia.gov
+//
+// *****************************************************************************
+//@HEADER
+*/
+
+#include <gtest/gtest.h>
+
+#include "test_harness.h"
+
+#include "serdes_headers.h"
+
+#include <atomic>
+#include <chrono>
+#include <string>
+#include <vector>
+#include <cstdio>
+#include <cstdlib>
+
+#include <unistd.h>
+
+namespace serdes { namespace tests { namespace unit {
+
+struct TestThrottledWriter : TestHarness {
+  virtual void SetUp() {
+    TestHarness::SetUp();
+    char dir_template[] = "/tmp/serdes-throttle-XXXXXX";
+    dir_ = mkdtemp(dir_template);
+  }
+
+  virtual void TearDown() {
+    for (auto&& path : paths_) {
+      std::remove(path.c_str());
+    }
+    rmdir(dir_.c_str());
+    TestHarness::TearDown();
+  }
+
+  std::string path(std::string const& name) {
+    paths_.push_back(dir_ + "/" + name);
+    return paths_.back();
+  }
+
+  std::string dir_;
+  std::vector<std::string> paths_;
+};
+
+TEST_F(TestThrottledWriter, test_throttled_rate_limit) {
+  using ClockType = std::chrono::steady_clock;
+
+  // 3 MiB of payload at 8 MiB/s with a 1 MiB burst takes at least 0.25s
+  static constexpr double const rate = 8.0 * 1024 * 1024;
+  std::vector<char> vec(3 * 1024 * 1024, 'c');
+  auto const file = path("throttled.bin");
+
+  auto const start = ClockType::now();
+  std::atomic<int> num_done(0);
+  {
+    ThrottledWriter writer(rate);
+    serializeToFileThrottled(vec, file, writer, [&](bool success){
+      EXPECT_TRUE(success);
+      num_done++;
+    });
+    writer.drain();
+    EXPECT_EQ(writer.getNumFailed(), 0UL);
+  }
+  std::chrono::duration<double> const elapsed = ClockType::now() - start;
+
+  EXPECT_EQ(num_done, 1);
+  EXPECT_GE(elapsed.count(), 0.2);
+
+  auto out = deserializeFromFile<std::vector<char>>(file);
+  ASSERT_NE(out, nullptr);
+  EXPECT_EQ(*out, vec);
+  delete out;
+}
+
+TEST_F(TestThrottledWriter, test_throttled_progress_backoff) {
+  static constexpr double const rate = 512.0 * 1024 * 1024;
+
+  // The application reports it is running at half speed: the writer must back
+  // off from its cap
+  ThrottledWriter writer(
+    rate, []{ return 0.5; }, 0.95, std::chrono::milliseconds(0)
+  );
+
+  AlignedBufferPool pool;
+  std::vector<double> vec(1024 * 1024, 3.0);
+  auto const file = path("backoff.bin");
+  serializeToFileThrottled(vec, file, writer, nullptr, &pool);
+  writer.drain();
+
+  EXPECT_EQ(writer.getNumFailed(), 0UL);
+  EXPECT_LT(writer.getCurrentRate(), rate);
+  EXPECT_EQ(writer.getMaxRate(), rate);
+
+  auto out = deserializeFromFile<std::vector<double>>(file);
+  ASSERT_NE(out, nullptr);
+  EXPECT_EQ(*out, vec);
+  delete out;
+}
+
+TEST_F(TestThrottledWriter, test_token_bucket_unlimited) {
+  TokenBucket bucket(0.0, 1);
+  // With no rate configured acquire never blocks
+  bucket.acquire(1024UL * 1024 * 1024);
+  EXPECT_EQ(bucket.getRate(), 0.0);
+}
+
+}}} // end namespace serdes::tests::unit
@@ -0,0 +1,214 @@
+/*
+//@HEADER
+// *****************************************************************************
+//
+//                                test_varint.cc
+//                           DARMA Toolkit v. 1.0.0
+//                 DARMA/checkpoint => Serialization Library
+//
+// Copyright 2019 National Technology & Engineering Solutions of Sandia, LLC
+// (NTESS). Under the terms of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the following disclaimer.
+//
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// * Neither the name of the copyright holder nor the names of its
+//   contributors may be used to endorse or promote products derived from this
+//   software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact darma@sandia.gov
+//
+// *****************************************************************************
+//@HEADER
+*/
+
+#include <gtest/gtest.h>
+
+#include "test_harness.h"
+
+#include "serdes_headers.h"
+
+#include <cstdint>
+#include <limits>
+#include <list>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace serdes { namespace tests { namespace unit {
+
+struct TestVarint : TestHarness {
+  struct Record {
+    int32_t delta = 0;
+    uint64_t id = 0;
+    std::vector<std::string> names;
+    std::map<int, std::list<char>> groups;
+    std::vector<int64_t> samples;
+    std::vector<double> values;
+
+    template <typename Serializer>
+    void serialize(Serializer& s) {
+      serializeVarint(s, delta);
+      serializeVarint(s, id);
+      s | names | groups;
+
+      SerialSizeType num = samples.size();
+      serializeVarint(s, num);
+      samples.resize(num);
+      serializeVarintArray(s, samples.data(), num);
+
+      s | values;
+    }
+  };
+
+  static Record makeRecord() {
+    Record rec;
+    rec.delta = -3;
+    rec.id = 1ull << 40;
+    for (int i = 0; i < 100; i++) {
+      rec.names.push_back(std::string(i % 7, 'n'));
+      rec.groups[i - 50] = std::list<char>(i % 3, 'g');
+    }
+    for (int i = 0; i < 1000; i++) {
+      rec.samples.push_back(i % 100 == 0 ? -(int64_t(1) << 50) : i % 60 - 30);
+    }
+    rec.values = {1.5, 2.5};
+    return rec;
+  }
+
+  static void expectEqual(Record const& a, Record const& b) {
+    EXPECT_EQ(a.delta, b.delta);
+    EXPECT_EQ(a.id, b.id);
+    EXPECT_EQ(a.names, b.names);
+    EXPECT_EQ(a.groups, b.groups);
+    EXPECT_EQ(a.samples, b.samples);
+    EXPECT_EQ(a.values, b.values);
+  }
+};
+
+TEST_F(TestVarint, test_varint_codec) {
+  SerialByteType bytes[max_varint_bytes];
+  for (uint64_t v : {0ull, 1ull, 127ull, 128ull, 300ull, ~0ull}) {
+    auto const len = encodeVarint(v, bytes);
+    EXPECT_EQ(len, varintLength(v));
+    uint64_t raw = 0;
+    EXPECT_EQ(decodeVarint(bytes, len, raw), len);
+    EXPECT_EQ(raw, v);
+    // A varint cut short by the end of the input is rejected
+    EXPECT_EQ(decodeVarint(bytes, len - 1, raw), 0u);
+  }
+
+  SerialByteType batch[4] = {1, 2};
+  EXPECT_EQ(encodeVarint(131, batch + 2), 2u);
+  int32_t out[3] = {};
+  EXPECT_TRUE(decodeVarintBatch(batch, 4, out, 3));
+  EXPECT_EQ(out[2], fromVarintRaw<int32_t>(131));
+  EXPECT_FALSE(decodeVarintBatch(batch, 3, out, 3));
+  EXPECT_EQ(varintLength(~0ull), max_varint_bytes);
+
+  // Zigzag keeps small magnitudes of either sign in one byte
+  EXPECT_EQ(toVarintRaw(int32_t(-1)), 1u);
+  EXPECT_EQ(toVarintRaw(int32_t(1)), 2u);
+  for (int64_t v : {int64_t(0), int64_t(-64), int64_t(63),
+                    std::numeric_limits<int64_t>::min(),
+                    std::numeric_limits<int64_t>::max()}) {
+    EXPECT_EQ(fromVarintRaw<int64_t>(toVarintRaw(v)), v);
+  }
+}
+
+TEST_F(TestVarint, test_varint_wire_modes) {
+  auto rec = makeRecord();
+
+  auto fixed = serializeTypeWithMode(rec, eWireMode::Fixed);
+  auto compact = serializeTypeWithMode(rec, eWireMode::Compact);
+  EXPECT_EQ(std::get<1>(fixed), wire_header_size + sizeType(rec));
+  EXPECT_LT(std::get<1>(compact) * 3, std::get<1>(fixed));
+
+  for (auto* ser : {&fixed, &compact}) {
+    auto out = deserializeTypeWithMode<Record>(
+      std::get<0>(*ser)->getBuffer(), std::get<1>(*ser)
+    );
+    expectEqual(*out, rec);
+    delete out;
+  }
+
+  // An unknown mode in the header is rejected rather than decoded
+  std::get<0>(compact)->getBuffer()[0] = 7;
+  EXPECT_EQ(
+    deserializeTypeWithMode<Record>(
+      std::get<0>(compact)->getBuffer(), std::get<1>(compact)
+    ),
+    nullptr
+  );
+}
+
+struct TestInterned : TestHarness {
+  struct Tagged {
+    std::vector<std::string> tags;
+
+    template <typename Serializer>
+    void serialize(Serializer& s) {
+      SerialSizeType num = tags.size();
+      serializeVarint(s, num);
+      tags.resize(num);
+      for (auto&& tag : tags) {
+        serializeInterned(s, tag);
+      }
+    }
+  };
+};
+
+TEST_F(TestInterned, test_interned_strings) {
+  Tagged in;
+  for (int i = 0; i < 200; i++) {
+    in.tags.push_back("a-fairly-long-label-" + std::to_string(i % 4));
+  }
+
+  // Compact mode writes each distinct string once; fixed mode writes them all
+  auto fixed = serializeTypeWithMode(in, eWireMode::Fixed);
+  auto compact = serializeTypeWithMode(in, eWireMode::Compact);
+  EXPECT_EQ(std::get<1>(fixed), wire_header_size + sizeType(in));
+  EXPECT_LT(std::get<1>(compact) * 10, std::get<1>(fixed));
+
+  for (auto* ser : {&fixed, &compact}) {
+    auto out = deserializeTypeWithMode<Tagged>(
+      std::get<0>(*ser)->getBuffer(), std::get<1>(*ser)
+    );
+    EXPECT_EQ(out->tags, in.tags);
+    delete out;
+  }
+}
+
+TEST_F(TestInterned, test_string_table_rejects_repeat) {
+  StringTable table;
+  EXPECT_TRUE(table.add("first"));
+  EXPECT_TRUE(table.add("second"));
+  EXPECT_FALSE(table.add("first"));
+  EXPECT_EQ(table.size(), 2UL);
+  ASSERT_NE(table.get(1), nullptr);
+  EXPECT_EQ(*table.get(1), "second");
+  EXPECT_EQ(table.get(2), nullptr);
+  EXPECT_EQ(table.intern("first").first, 0UL);
+}
+
+}}} // end namespace serdes::tests::unit